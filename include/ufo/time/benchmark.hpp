@@ -0,0 +1,247 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_BENCHMARK_HPP
+#define UFO_TIME_BENCHMARK_HPP
+
+// UFO
+#include <ufo/time/timer.hpp>
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Makes the compiler assume `value` is used, so the computation of it is not
+ * optimized away.
+ */
+template <class T>
+inline void doNotOptimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static_cast<void>(*reinterpret_cast<char const volatile*>(&value));
+#endif
+}
+
+/*!
+ * @brief Makes the compiler assume all memory is read and written, so pending stores are
+ * not optimized away.
+ */
+inline void clobberMemory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : : "memory");
+#else
+	std::atomic_signal_fence(std::memory_order_acq_rel);
+#endif
+}
+
+struct BenchmarkOptions {
+	// Time the function is run before measuring
+	std::chrono::nanoseconds warmup = std::chrono::milliseconds(100);
+	// Minimum time of a repetition, the number of iterations per repetition is chosen to
+	// reach it
+	std::chrono::nanoseconds min_repetition_time = std::chrono::milliseconds(1);
+	// Repetitions stop when half the confidence interval divided by the mean is below this
+	double relative_error = 0.01;
+	double confidence     = 0.95;
+	// Limits on the repetitions, `max_time` excludes the warmup
+	std::size_t              min_repetitions = 10;
+	std::size_t              max_repetitions = 1000;
+	std::chrono::nanoseconds max_time        = std::chrono::seconds(10);
+	// Repetitions with a modified z-score (from the median and the median absolute
+	// deviation) above this are outliers, zero keeps all
+	double outlier_threshold = 3.5;
+	// CPU to pin the benchmarking thread to while running, negative to not pin
+	int cpu = -1;
+};
+
+struct BenchmarkResult {
+	struct Repetition {
+		std::chrono::high_resolution_clock::duration real;
+		std::chrono::nanoseconds                     cpu;
+		bool                                         outlier;
+	};
+
+	std::string name;
+	// Iterations per repetition
+	std::size_t             iterations = 0;
+	std::vector<Repetition> repetitions;
+	// The repetitions that are not outliers
+	Timer timer;
+	// Whether the relative error was reached
+	bool converged = false;
+
+	// Per iteration and in seconds, over the repetitions that are not outliers
+	double mean    = 0.0;
+	double median  = 0.0;
+	double std_dev = 0.0;
+	double ci_low  = 0.0;
+	double ci_high = 0.0;
+
+	[[nodiscard]] std::size_t numOutliers() const;
+
+	/*!
+	 * @brief Half the confidence interval divided by the mean.
+	 *
+	 * @return The relative error, or infinity if the mean is not positive (e.g., no
+	 * repetitions were run or the body takes no measurable time), so it never converges.
+	 */
+	[[nodiscard]] double relativeError() const;
+};
+
+/*!
+ * @brief Runs functions repeatedly until their mean time is known to a given relative
+ * error.
+ *
+ * Each function is first run for a warmup period. The number of iterations per repetition
+ * is then doubled until a repetition takes at least `min_repetition_time`, and
+ * repetitions are added until the confidence interval of the mean is narrow enough.
+ * Outliers, e.g., from preemption, are left out of the statistics.
+ */
+class Benchmark
+{
+ public:
+	explicit Benchmark(BenchmarkOptions const& options = {});
+
+	/*!
+	 * @brief Benchmarks `f`, which is called without arguments.
+	 *
+	 * @return The result, valid until the next call to `run` or `clear`.
+	 */
+	template <class F>
+	BenchmarkResult const& run(std::string const& name, F f)
+	{
+		return runImpl(name, [&f](std::size_t iterations) {
+			for (std::size_t i{}; iterations != i; ++i) {
+				f();
+			}
+		});
+	}
+
+	[[nodiscard]] BenchmarkOptions const& options() const;
+
+	[[nodiscard]] std::vector<BenchmarkResult> const& results() const;
+
+	void clear();
+
+	template <class Period = std::chrono::seconds::period>
+	void print(std::string const& name = "", int precision = 4) const
+	{
+		std::vector<std::pair<int, std::string>> tags;
+		std::vector<std::string>                 colors;
+		std::vector<std::vector<std::wstring>>   columns{
+		      {L" Mean "},    {L" Median "}, {L" Std dev "},     {L" CI low "},
+		      {L" CI high "}, {L" ± % "},    {L" Iterations "}, {L" Repetitions "}};
+
+		auto fixed = [precision](double value) {
+			std::wstringstream ss;
+			ss << std::fixed << std::setprecision(precision) << L' ' << value << L' ';
+			return ss.str();
+		};
+		auto period = [](double seconds) {
+			return std::chrono::duration<double, Period>(std::chrono::duration<double>(seconds))
+			    .count();
+		};
+
+		for (auto const& r : results_) {
+			tags.emplace_back(0, r.name);
+			colors.push_back(r.converged ? "" : Timing::yellowColor());
+
+			columns[0].push_back(fixed(period(r.mean)));
+			columns[1].push_back(fixed(period(r.median)));
+			columns[2].push_back(fixed(period(r.std_dev)));
+			columns[3].push_back(fixed(period(r.ci_low)));
+			columns[4].push_back(fixed(period(r.ci_high)));
+			columns[5].push_back(fixed(100 * r.relativeError()));
+			columns[6].push_back(L" " + std::to_wstring(r.iterations) + L" ");
+			columns[7].push_back(L" " +
+			                     std::to_wstring(r.repetitions.size() - r.numOutliers()) +
+			                     L"/" + std::to_wstring(r.repetitions.size()) + L" ");
+		}
+
+		std::vector<std::pair<std::wstring, std::wstring>> component{{L" Benchmark ", L""}};
+		Timing::addTags(component, tags);
+
+		Timing::printTable(Timing::header(name.empty() ? "Benchmark" : name,
+		                                  Timing::unit<Period>()),
+		                   component, colors, columns, false);
+	}
+
+	void printSeconds(std::string const& name = "", int precision = 4) const;
+
+	void printMilliseconds(std::string const& name = "", int precision = 4) const;
+
+	void printMicroseconds(std::string const& name = "", int precision = 4) const;
+
+	void printNanoseconds(std::string const& name = "", int precision = 4) const;
+
+	/*!
+	 * @brief Writes the results in the JSON format of Google Benchmark, so they can be
+	 * compared with its tools (e.g., compare.py).
+	 *
+	 * @note Only the repetitions that are not outliers are written.
+	 */
+	void writeJson(std::ostream& out) const;
+
+ private:
+	BenchmarkResult const& runImpl(std::string const&                      name,
+	                               std::function<void(std::size_t)> const& f);
+
+ private:
+	BenchmarkOptions             options_;
+	std::vector<BenchmarkResult> results_;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_BENCHMARK_HPP
@@ -0,0 +1,147 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_CONCURRENT_TIMER_HPP
+#define UFO_TIME_CONCURRENT_TIMER_HPP
+
+// UFO
+#include <ufo/time/timer.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+
+// POSIX
+#include <sched.h>
+
+namespace ufo
+{
+/*!
+ * @brief A timer that many threads can add samples to at the same time.
+ *
+ * The samples are added to one of several cache line sized shards, chosen by the CPU the
+ * thread runs on, so threads on different CPUs never write to the same memory. The
+ * statistics of the shards are combined exactly into a `Timer` when read.
+ *
+ * @note Each shard is guarded by a spinlock that writers only try to take: if the shard
+ * of their CPU is in use (e.g., the thread using it was preempted) they try the next.
+ * Only when every shard is in use do they spin, yielding between the rounds, so with the
+ * default number of shards writers rarely wait. Reading waits for each shard in turn.
+ */
+class ConcurrentTimer
+{
+ public:
+	/*!
+	 * @param shards Number of shards, rounded up to a power of two. Zero uses twice the
+	 * number of CPUs, so a thread preempted while adding a sample rarely makes others
+	 * search for a free shard.
+	 */
+	explicit ConcurrentTimer(std::size_t shards = 0);
+
+	ConcurrentTimer(ConcurrentTimer const&) = delete;
+
+	ConcurrentTimer& operator=(ConcurrentTimer const&) = delete;
+
+	/*!
+	 * @brief Adds a sample, can be called from any thread.
+	 */
+	void addSample(std::chrono::time_point<std::chrono::high_resolution_clock> start,
+	               std::chrono::time_point<std::chrono::high_resolution_clock> stop)
+	{
+		auto& s = acquire();
+		s.timer.addSample(start, stop);
+		s.busy.store(false, std::memory_order_release);
+	}
+
+	/*!
+	 * @brief The statistics of all samples.
+	 */
+	[[nodiscard]] Timer timer() const;
+
+	void reset();
+
+	[[nodiscard]] std::size_t numShards() const;
+
+ private:
+	struct alignas(64) Shard {
+		std::atomic<bool> busy{false};
+		Timer             timer;
+	};
+
+	Shard& acquire()
+	{
+		for (std::size_t i = cpu();; ++i) {
+			auto& s = shards_[i & mask_];
+			// Reading first keeps the cache line shared while it is busy
+			if (!s.busy.load(std::memory_order_relaxed) &&
+			    !s.busy.exchange(true, std::memory_order_acquire)) {
+				return s;
+			}
+			// All shards are in use by preempted threads
+			if (mask_ == (i & mask_)) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	static std::size_t cpu()
+	{
+#ifdef __linux__
+		if (int c = ::sched_getcpu(); 0 <= c) {
+			return static_cast<std::size_t>(c);
+		}
+#endif
+		thread_local std::size_t const id = std::hash<std::thread::id>{}(
+		    std::this_thread::get_id());
+		return id;
+	}
+
+ private:
+	std::unique_ptr<Shard[]> shards_;
+	std::size_t              mask_;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_CONCURRENT_TIMER_HPP
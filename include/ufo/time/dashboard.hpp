@@ -0,0 +1,177 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_DASHBOARD_HPP
+#define UFO_TIME_DASHBOARD_HPP
+
+// UFO
+#include <ufo/time/timing.hpp>
+#include <ufo/time/timing_snapshot.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Redraws a `Timing` tree in place in the terminal, in the style of `print`.
+ *
+ * Next to the cumulative total and number of samples it shows, for the interval since
+ * the previous redraw, the samples per second, the time per second, the share of the
+ * frame, and the mean. The frame is the root timing if it had samples in the interval,
+ * else the interval itself. Siblings are sorted by their time in the interval, hottest
+ * first.
+ *
+ * @note The tree is read through a `TimingSnapshot`, see its constructor for the locking.
+ * The `Timing` has to outlive the dashboard.
+ */
+class Dashboard
+{
+ public:
+	explicit Dashboard(Timing const& timing, std::string const& name = "");
+
+	/*!
+	 * @brief Draws to `out` instead of the standard output, `out` has to outlive the
+	 * dashboard.
+	 */
+	Dashboard(Timing const& timing, std::ostream& out, std::string const& name = "");
+
+	Dashboard(Dashboard const&) = delete;
+
+	Dashboard& operator=(Dashboard const&) = delete;
+
+	~Dashboard();
+
+	/*!
+	 * @brief Redraws every `interval` from a background thread.
+	 *
+	 * @note Has no effect if the dashboard is already shown.
+	 */
+	template <class Period = std::chrono::milliseconds::period>
+	void show(std::chrono::milliseconds interval = std::chrono::seconds(1),
+	          int                       precision = 4)
+	{
+		show(interval, precision, unit<Period>());
+	}
+
+	void showSeconds(std::chrono::milliseconds interval = std::chrono::seconds(1),
+	                 int                       precision = 4);
+
+	void showMilliseconds(std::chrono::milliseconds interval = std::chrono::seconds(1),
+	                      int                       precision = 4);
+
+	void showMicroseconds(std::chrono::milliseconds interval = std::chrono::seconds(1),
+	                      int                       precision = 4);
+
+	void showNanoseconds(std::chrono::milliseconds interval = std::chrono::seconds(1),
+	                     int                       precision = 4);
+
+	/*!
+	 * @brief Redraws once, the interval is the time since the previous redraw.
+	 */
+	template <class Period = std::chrono::milliseconds::period>
+	void draw(int precision = 4)
+	{
+		draw(precision, unit<Period>());
+	}
+
+	void drawSeconds(int precision = 4);
+
+	void drawMilliseconds(int precision = 4);
+
+	void drawMicroseconds(int precision = 4);
+
+	void drawNanoseconds(int precision = 4);
+
+	/*!
+	 * @brief Stops the background thread.
+	 */
+	void stop();
+
+	[[nodiscard]] bool showing() const;
+
+ private:
+	struct Unit {
+		double       seconds;
+		std::wstring name;
+		std::wstring short_name;
+	};
+
+	template <class Period>
+	static Unit unit()
+	{
+		using Seconds = std::chrono::duration<double>;
+		return {Seconds(std::chrono::duration<double, Period>(1)).count(),
+		        Timing::unit<Period>(), Timing::shortUnit<Period>()};
+	}
+
+	void show(std::chrono::milliseconds interval, int precision, Unit unit);
+
+	void draw(int precision, Unit const& unit);
+
+	void write(std::string const& str);
+
+ private:
+	Timing const& timing_;
+	std::string   name_;
+	// The standard output if null
+	std::ostream* out_ = nullptr;
+
+	// The tree at the previous redraw
+	std::mutex                                                  draw_mutex_;
+	TimingSnapshot                                              previous_;
+	std::chrono::time_point<std::chrono::high_resolution_clock> previous_time_;
+
+	std::atomic_bool        running_{false};
+	std::mutex              mutex_;
+	std::condition_variable cv_;
+	std::thread             thread_;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_DASHBOARD_HPP
@@ -0,0 +1,188 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_FLAT_PROFILE_HPP
+#define UFO_TIME_FLAT_PROFILE_HPP
+
+// UFO
+#include <ufo/time/timer.hpp>
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <codecvt>
+#include <cstddef>
+#include <iomanip>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Aggregates the nodes of a `Timing` tree that have the same tag, like the flat
+ * profile of gprof, so the total cost of an operation that is timed under many parents
+ * is on one row.
+ *
+ * An occurrence of a tag within another occurrence of the same tag (recursion) adds to
+ * the exclusive time and the calls, but not to the inclusive time, so it is not counted
+ * twice.
+ */
+class FlatProfile
+{
+ public:
+	struct Entry {
+		std::string tag;
+		// Of the occurrences that are not within another occurrence
+		Timer inclusive;
+		// Time not spent in children, over all occurrences, in seconds
+		double exclusive = 0.0;
+		// Samples of all occurrences
+		int calls = 0;
+		// Inclusive time per parent tag in seconds, most first
+		std::vector<std::pair<std::string, double>> parents;
+	};
+
+	explicit FlatProfile(Timing const& timing);
+
+	/*!
+	 * @brief The entries, most exclusive time first.
+	 */
+	[[nodiscard]] std::vector<Entry> const& entries() const;
+
+	/*!
+	 * @brief The entry of `tag`, nullptr if there is none.
+	 */
+	[[nodiscard]] Entry const* find(std::string const& tag) const;
+
+	/*!
+	 * @brief The sum of the exclusive times, in seconds.
+	 */
+	[[nodiscard]] double total() const;
+
+	template <class Period = std::chrono::seconds::period>
+	void print(std::string const& name = "", std::size_t parents = 3,
+	           int precision = 4) const
+	{
+		std::vector<std::pair<int, std::string>> tags;
+		std::vector<std::string>                 colors;
+		std::vector<std::vector<std::wstring>>   columns{
+		      {L" Exclusive "}, {L" % "},    {L" Inclusive "},
+		      {L" % "},         {L" Mean "}, {L" Calls "},     {L" Parents "}};
+
+		auto fixed = [](double value, int precision) {
+			std::wstringstream ss;
+			ss << std::fixed << std::setprecision(precision) << L' ' << value << L' ';
+			return ss.str();
+		};
+		auto period = [](double seconds) {
+			return std::chrono::duration<double, Period>(std::chrono::duration<double>(seconds))
+			    .count();
+		};
+		auto percent = [this](double seconds) {
+			return 0.0 < total_ ? 100.0 * seconds / total_ : 0.0;
+		};
+
+		std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
+
+		for (auto const& e : entries_) {
+			tags.emplace_back(0, e.tag);
+			colors.push_back("");
+
+			auto inclusive = e.inclusive.totalSeconds();
+			columns[0].push_back(fixed(period(e.exclusive), precision));
+			columns[1].push_back(fixed(percent(e.exclusive), 1));
+			columns[2].push_back(fixed(period(inclusive), precision));
+			columns[3].push_back(fixed(percent(inclusive), 1));
+			columns[4].push_back(fixed(e.inclusive.mean<Period>(), precision));
+			columns[5].push_back(L" " + std::to_wstring(e.calls) + L" ");
+
+			std::wstringstream ss;
+			for (std::size_t i{}; std::min(parents, e.parents.size()) != i; ++i) {
+				auto const& [tag, seconds] = e.parents[i];
+				ss << (0 == i ? L" " : L", ") << converter.from_bytes(tag) << L' '
+				   << std::fixed << std::setprecision(0)
+				   << (0.0 < inclusive ? 100.0 * seconds / inclusive : 0.0) << L'%';
+			}
+			if (parents < e.parents.size()) {
+				ss << L", ...";
+			}
+			ss << L' ';
+			columns[6].push_back(ss.str());
+		}
+
+		std::vector<std::pair<std::wstring, std::wstring>> component{{L" Tag ", L""}};
+		Timing::addTags(component, tags);
+
+		Timing::printTable(Timing::header(name.empty() ? "Flat profile" : name,
+		                                  Timing::unit<Period>()),
+		                   component, colors, columns, false);
+	}
+
+	void printSeconds(std::string const& name = "", std::size_t parents = 3,
+	                  int precision = 4) const;
+
+	void printMilliseconds(std::string const& name = "", std::size_t parents = 3,
+	                       int precision = 4) const;
+
+	void printMicroseconds(std::string const& name = "", std::size_t parents = 3,
+	                       int precision = 4) const;
+
+	void printNanoseconds(std::string const& name = "", std::size_t parents = 3,
+	                      int precision = 4) const;
+
+ private:
+	void addRecurs(Timing const& timing, std::string const& parent,
+	               std::vector<std::string>& ancestors);
+
+ private:
+	std::vector<Entry> entries_;
+	// Index of each tag in `entries_`
+	std::unordered_map<std::string, std::size_t> index_;
+	double                                       total_ = 0.0;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_FLAT_PROFILE_HPP
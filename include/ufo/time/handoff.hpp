@@ -0,0 +1,142 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_HANDOFF_HPP
+#define UFO_TIME_HANDOFF_HPP
+
+// UFO
+#include <ufo/time/timer.hpp>
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <chrono>
+#include <type_traits>
+
+namespace ufo
+{
+/*!
+ * @brief A timestamp that travels with a work item between threads, to time intervals
+ * that start on one thread and stop on another (e.g., queue wait in a pipeline or the
+ * latency from a sensor timestamp to the map being updated).
+ *
+ * The producer creates the handoff and passes it along with the item. Each stage calls
+ * `lap` to record the time since the previous lap (or since the origin) and `finish`
+ * records the time since the origin.
+ *
+ * @code
+ * // Producer
+ * queue.push({cloud, Handoff(cloud.stamp)});
+ * // Consumer
+ * auto [cloud, h] = queue.pop();
+ * h.lap(timing["Integration"]["Queue wait"]);
+ * integrate(cloud);
+ * h.lap(timing["Integration"]["Service"]);
+ * h.finish(timing["End-to-end"]);
+ * @endcode
+ */
+class Handoff
+{
+ public:
+	/*!
+	 * @brief Starts the handoff now.
+	 */
+	Handoff();
+
+	explicit Handoff(std::chrono::time_point<std::chrono::high_resolution_clock> origin);
+
+	/*!
+	 * @brief Starts the handoff at a time point from another clock (e.g., a sensor
+	 * timestamp in `std::chrono::system_clock`), converted by the current offset between
+	 * the clocks.
+	 */
+	template <class Clock, class Duration,
+	          std::enable_if_t<!std::is_same_v<Clock, std::chrono::high_resolution_clock>,
+	                           bool> = true>
+	explicit Handoff(std::chrono::time_point<Clock, Duration> origin)
+	    : Handoff(std::chrono::high_resolution_clock::now() -
+	              std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+	                  Clock::now() - origin))
+	{
+	}
+
+	/*!
+	 * @brief Adds the time since the previous lap, or since the origin for the first
+	 * lap, as a sample to `timing` and starts the next lap.
+	 */
+	Handoff& lap(Timing& timing);
+
+	Handoff& lap(Timer& timer);
+
+	/*!
+	 * @brief Adds the time since the origin as a sample to `timing`.
+	 */
+	void finish(Timing& timing) const;
+
+	void finish(Timer& timer) const;
+
+	[[nodiscard]] std::chrono::time_point<std::chrono::high_resolution_clock> origin() const;
+
+	[[nodiscard]] std::chrono::time_point<std::chrono::high_resolution_clock> lastLap()
+	    const;
+
+	template <class Period = std::chrono::seconds::period>
+	[[nodiscard]] double elapsed() const
+	{
+		return std::chrono::duration<double, Period>(
+		           std::chrono::high_resolution_clock::now() - origin_)
+		    .count();
+	}
+
+	[[nodiscard]] double elapsedSeconds() const;
+
+	[[nodiscard]] double elapsedMilliseconds() const;
+
+	[[nodiscard]] double elapsedMicroseconds() const;
+
+	[[nodiscard]] double elapsedNanoseconds() const;
+
+ private:
+	std::chrono::time_point<std::chrono::high_resolution_clock> origin_;
+	std::chrono::time_point<std::chrono::high_resolution_clock> last_lap_;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_HANDOFF_HPP
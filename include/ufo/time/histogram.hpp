@@ -0,0 +1,130 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_HISTOGRAM_HPP
+#define UFO_TIME_HISTOGRAM_HPP
+
+// STL
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Log-linear histogram of durations.
+ *
+ * Durations are bucketed by their power of two, with each power of two split into 16
+ * linear sub-buckets, so the relative error of a percentile is at most 1/32. Memory
+ * grows with the longest duration added, to at most a few kilobytes.
+ */
+class Histogram
+{
+ public:
+	void add(std::chrono::high_resolution_clock::duration duration,
+	         std::uint64_t                                count = 1);
+
+	void reset();
+
+	Histogram& operator+=(Histogram const& rhs);
+
+	friend Histogram operator+(Histogram lhs, Histogram const& rhs);
+
+	[[nodiscard]] std::uint64_t count() const;
+
+	[[nodiscard]] bool empty() const;
+
+	/*!
+	 * @brief The `p`th percentile, with `p` in [0, 100].
+	 *
+	 * @return The percentile, or NaN if the histogram is empty.
+	 */
+	template <class Period = std::chrono::seconds::period>
+	[[nodiscard]] double percentile(double p) const
+	{
+		return empty() ? std::numeric_limits<double>::quiet_NaN()
+		               : std::chrono::duration<double, Period>(percentileDuration(p))
+		                     .count();
+	}
+
+	[[nodiscard]] double percentileSeconds(double p) const;
+
+	[[nodiscard]] double percentileMilliseconds(double p) const;
+
+	[[nodiscard]] double percentileMicroseconds(double p) const;
+
+	[[nodiscard]] double percentileNanoseconds(double p) const;
+
+	/*!
+	 * @brief The non-empty buckets, as (lower bound, upper bound, count).
+	 */
+	[[nodiscard]] std::vector<
+	    std::tuple<std::chrono::high_resolution_clock::duration,
+	               std::chrono::high_resolution_clock::duration, std::uint64_t>>
+	buckets() const;
+
+	/*!
+	 * @brief Number of bytes allocated for the buckets, not counting the object itself.
+	 */
+	[[nodiscard]] std::size_t memoryUsage() const;
+
+ private:
+	[[nodiscard]] std::chrono::high_resolution_clock::duration percentileDuration(
+	    double p) const;
+
+	[[nodiscard]] static std::size_t index(std::uint64_t value);
+
+	[[nodiscard]] static std::uint64_t lowerBound(std::size_t index);
+
+	[[nodiscard]] static std::uint64_t width(std::size_t index);
+
+ private:
+	static constexpr int SUB_BITS = 4;
+
+	std::vector<std::uint64_t> counts_;
+	std::uint64_t              count_ = 0;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_HISTOGRAM_HPP
@@ -0,0 +1,235 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_JOURNAL_HPP
+#define UFO_TIME_JOURNAL_HPP
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ufo
+{
+class Timing;
+
+/*!
+ * @brief Append-only, memory-mapped journal of the start and stop events of a `Timing`
+ * tree, for long runs where the timings must survive a crash.
+ *
+ * The file is a header followed by fixed-size chunks. Each chunk belongs to one thread
+ * and holds varint encoded records: node definitions (id, parent and tag) and start/stop
+ * events with the time since the previous event of the chunk. The number of valid bytes
+ * of a chunk is updated after each record, so the journal is readable up to the last
+ * record written if the process dies, and up to the last `flush` if the machine does.
+ *
+ * @note One `Timing` tree per journal, attach it with `Timing::setJournal`.
+ */
+class Journal
+{
+ public:
+	/*!
+	 * @param path The journal file, truncated if it exists.
+	 * @param chunk_size Size of the per-thread chunks, rounded up to a multiple of the page
+	 * size.
+	 */
+	explicit Journal(std::string const& path, std::size_t chunk_size = 1 << 20);
+
+	Journal(Journal const&) = delete;
+
+	Journal& operator=(Journal const&) = delete;
+
+	~Journal();
+
+	[[nodiscard]] bool isOpen() const;
+
+	[[nodiscard]] std::string const& path() const;
+
+	/*!
+	 * @brief Writes the journal to disk.
+	 */
+	void flush();
+
+ private:
+	struct Writer {
+		std::uint32_t  thread;
+		unsigned char* chunk = nullptr;
+		// Write position in the chunk
+		std::size_t  offset = 0;
+		std::int64_t last   = 0;
+		// Nodes already defined in the journal, valid while `generation` is current
+		std::unordered_map<Timing const*, std::uint32_t> ids;
+		std::uint64_t                                    generation = 0;
+	};
+
+	struct Definition {
+		std::uint32_t id;
+		std::uint32_t parent;  // Zero for no parent, else id + 1
+		std::string   tag;
+		// The node defined, only known when writing
+		Timing const* node = nullptr;
+	};
+
+	void start(Timing const& node,
+	           std::chrono::time_point<std::chrono::high_resolution_clock> time);
+
+	void stop(Timing const& node,
+	          std::chrono::time_point<std::chrono::high_resolution_clock> time);
+
+	void event(Timing const& node,
+	           std::chrono::time_point<std::chrono::high_resolution_clock> time, bool stop);
+
+	Writer& writer();
+
+	std::uint32_t id(Writer& w, Timing const& node);
+
+	void define(Timing const& node, std::vector<Definition>& definitions);
+
+	/*!
+	 * @brief Forgets the id of `node`, which is about to be destroyed, so a node later
+	 * created at the same address gets a new id.
+	 */
+	void forget(Timing const& node);
+
+	/*!
+	 * @brief Space for a record of at most `size` bytes in the chunk of `w`, a new chunk
+	 * is started if needed.
+	 *
+	 * @return Where to write the record, or nullptr on failure.
+	 */
+	unsigned char* reserve(Writer& w, std::size_t size);
+
+	/*!
+	 * @brief Makes the `size` bytes written after `reserve` part of the journal.
+	 */
+	void commit(Writer& w, std::size_t size);
+
+	bool newChunk(Writer& w);
+
+ private:
+	static constexpr std::size_t CHUNK_HEADER_SIZE = 32;
+
+	std::string path_;
+	int         fd_ = -1;
+	// The header takes a page, so the chunks are page aligned
+	std::size_t header_size_;
+	std::size_t chunk_size_;
+	std::size_t file_size_;
+
+	// Identifies the journal in the thread local cache of writers
+	std::uint64_t serial_;
+
+	std::mutex                                          mutex_;
+	std::map<std::thread::id, std::unique_ptr<Writer>> writers_;
+	std::unordered_map<Timing const*, std::uint32_t>    ids_;
+	std::uint32_t                                       next_id_ = 0;
+	// Incremented by `forget`, the writers then drop their cached ids
+	std::atomic<std::uint64_t> generation_{0};
+
+	friend class Timing;
+	friend class JournalReader;
+};
+
+/*!
+ * @brief Reads a journal written by `Journal`, also one that was cut short by a crash.
+ */
+class JournalReader
+{
+ public:
+	explicit JournalReader(std::string const& path);
+
+	JournalReader(JournalReader const&) = delete;
+
+	JournalReader& operator=(JournalReader const&) = delete;
+
+	~JournalReader();
+
+	[[nodiscard]] bool isOpen() const;
+
+	[[nodiscard]] std::size_t numChunks() const;
+
+	/*!
+	 * @brief Converts a time point of the journal to wall clock time.
+	 */
+	[[nodiscard]] std::chrono::system_clock::time_point toSystemTime(
+	    std::chrono::time_point<std::chrono::high_resolution_clock> time) const;
+
+	/*!
+	 * @brief Adds the intervals that started at or after `first` and stopped at or before
+	 * `last` to `timing`, which takes the place of the root of the journaled tree.
+	 *
+	 * @note The chunks are decoded by `num_threads` threads, the threads of the journal
+	 * are replayed independently of each other.
+	 *
+	 * @return The number of intervals added.
+	 */
+	std::size_t read(
+	    Timing& timing,
+	    std::chrono::time_point<std::chrono::high_resolution_clock> first =
+	        std::chrono::time_point<std::chrono::high_resolution_clock>::min(),
+	    std::chrono::time_point<std::chrono::high_resolution_clock> last =
+	        std::chrono::time_point<std::chrono::high_resolution_clock>::max(),
+	    unsigned num_threads = std::thread::hardware_concurrency()) const;
+
+ private:
+	[[nodiscard]] unsigned char const* chunk(std::size_t index) const;
+
+ private:
+	int                  fd_   = -1;
+	unsigned char const* data_ = nullptr;
+	std::size_t          size_ = 0;
+	std::size_t          header_size_{};
+	std::size_t          chunk_size_{};
+	std::int64_t         system_origin_{};
+	std::int64_t         clock_origin_{};
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_JOURNAL_HPP
@@ -0,0 +1,124 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_OPEN_METRICS_EXPORTER_HPP
+#define UFO_TIME_OPEN_METRICS_EXPORTER_HPP
+
+// UFO
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ufo
+{
+/*!
+ * @brief Exports a `Timing` tree in the OpenMetrics text format, either to a file (e.g.,
+ * for the node_exporter textfile collector) or over HTTP on a loopback address.
+ *
+ * @note The exported `Timing` has to outlive the exporter.
+ */
+class OpenMetricsExporter
+{
+ public:
+	OpenMetricsExporter(Timing const& timing, std::string const& prefix = "ufotime");
+
+	OpenMetricsExporter(OpenMetricsExporter const&) = delete;
+
+	OpenMetricsExporter& operator=(OpenMetricsExporter const&) = delete;
+
+	~OpenMetricsExporter();
+
+	/*!
+	 * @brief Writes the current timings to `path`.
+	 *
+	 * @note The file is written next to `path` and then renamed, so a reader never sees
+	 * a partially written file.
+	 *
+	 * @return Whether the file was written.
+	 */
+	bool write(std::string const& path) const;
+
+	/*!
+	 * @brief Rewrites `path` every `interval` from a background thread.
+	 *
+	 * @note Has no effect if the exporter is already writing periodically.
+	 */
+	void writePeriodically(std::string const& path, std::chrono::milliseconds interval =
+	                                                    std::chrono::seconds(15));
+
+	/*!
+	 * @brief Serves the timings at `http://127.0.0.1:<port>/metrics` from a background
+	 * thread.
+	 *
+	 * @note Has no effect if the exporter is already serving.
+	 *
+	 * @return Whether the exporter is serving.
+	 */
+	bool serve(std::uint16_t port);
+
+	/*!
+	 * @brief Stops all background threads.
+	 */
+	void stop();
+
+ private:
+	void serveLoop(int socket);
+
+ private:
+	Timing const& timing_;
+	std::string   prefix_;
+
+	std::atomic_bool        running_{false};
+	std::mutex              mutex_;
+	std::condition_variable cv_;
+	std::thread             file_thread_;
+	std::thread             http_thread_;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_OPEN_METRICS_EXPORTER_HPP
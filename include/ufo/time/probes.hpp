@@ -0,0 +1,77 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_PROBES_HPP
+#define UFO_TIME_PROBES_HPP
+
+/*!
+ * USDT (SystemTap compatible) probes, built in with the `UFOTIME_USDT` CMake option. A
+ * probe is a single NOP until a tracer attaches to it, so timings of a live process can
+ * be collected with, e.g., `bpftrace` or `perf` without collecting them in the library:
+ *
+ * @code
+ * bpftrace -e 'usdt:/path/to/libUFOTime.so:ufotime:timing__stop
+ *              /str(arg2) == "Integrate"/ { @ns[tid] = hist(arg3); }'
+ * @endcode
+ *
+ * The probes, in the `ufotime` provider, are:
+ * - `timing__start(node, parent, tag)`
+ * - `timing__stop(node, parent, tag, nanoseconds)`
+ * - `timer__stop(timer, nanoseconds)`, in the program since `Timer::stop` is inlined
+ *
+ * `node` and `parent` identify the `Timing` nodes, so paths can be built by the tracer,
+ * and the thread is the thread the probe fires on. Without `UFOTIME_USDT` the arguments
+ * are not evaluated.
+ */
+
+#if defined(UFOTIME_USDT) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+
+#define UFOTIME_PROBE2(name, a1, a2) DTRACE_PROBE2(ufotime, name, a1, a2)
+#define UFOTIME_PROBE3(name, a1, a2, a3) DTRACE_PROBE3(ufotime, name, a1, a2, a3)
+#define UFOTIME_PROBE4(name, a1, a2, a3, a4) DTRACE_PROBE4(ufotime, name, a1, a2, a3, a4)
+#else
+#define UFOTIME_PROBE2(name, a1, a2) static_cast<void>(0)
+#define UFOTIME_PROBE3(name, a1, a2, a3) static_cast<void>(0)
+#define UFOTIME_PROBE4(name, a1, a2, a3, a4) static_cast<void>(0)
+#endif
+
+#endif  // UFO_TIME_PROBES_HPP
@@ -0,0 +1,221 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_PROFILER_HPP
+#define UFO_TIME_PROFILER_HPP
+
+// UFO
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// POSIX
+#include <signal.h>
+#include <time.h>
+
+namespace ufo
+{
+struct ProfilerOptions {
+	// CPU time a thread runs between two of its samples
+	std::chrono::nanoseconds interval = std::chrono::milliseconds(1);
+	// Frames of the call stack captured per sample, at most `Profiler::MAX_STACK_DEPTH`.
+	// Zero only attributes the samples to the scopes.
+	int stack_depth = 16;
+	// Samples kept, later samples are dropped. Each takes `stack_depth` pointers, which
+	// are only touched once written.
+	std::size_t capacity = std::size_t(1) << 16;
+};
+
+/*!
+ * @brief A sampling profiler that attributes each sample to the `Timing` scope the
+ * sampled thread is in.
+ *
+ * Each attached thread gets a timer on its CPU time clock that raises `SIGPROF`. The
+ * signal handler records the deepest running timing of the thread and, optionally, its
+ * call stack. The report shows which functions, annotated or not, the time inside each
+ * scope is spent in, without adding more `start`/`stop` pairs:
+ *
+ * @code
+ * ufo::Timing   timing;
+ * ufo::Profiler profiler(timing);
+ * profiler.start();
+ * // ...
+ * profiler.stop();
+ * profiler.print();
+ * @endcode
+ *
+ * @note The handler only writes to preallocated slots. It calls `backtrace`, which POSIX
+ * does not list as async-signal-safe; on glibc it is once its unwinder is loaded, which
+ * `start` does before installing the handler. The handler stays installed after the
+ * profiler stops. Only one profiler can run at a time, and the threads to sample call
+ * `attach`. `start` attaches the calling thread.
+ *
+ * @note Function names are looked up with `dladdr`, so functions in an executable are
+ * only named if it is linked with `-rdynamic`. Other frames are shown as module and
+ * offset.
+ *
+ * @note `timing` must outlive the profiler.
+ */
+class Profiler
+{
+ public:
+	static constexpr int MAX_STACK_DEPTH = 64;
+
+	struct Function {
+		std::string name;
+		// Samples with the function innermost in the stack
+		std::size_t self = 0;
+		// Samples with the function anywhere in the stack
+		std::size_t total = 0;
+	};
+
+	struct Scope {
+		// Tags from the root, empty for the samples taken outside of the profiled tree
+		std::vector<std::string> path;
+		// Samples taken in the scope but not in any of its children
+		std::size_t samples = 0;
+		// Samples taken in the scope and its children
+		std::size_t total = 0;
+		// Most sampled first
+		std::vector<Function> functions;
+	};
+
+	explicit Profiler(Timing const& timing, ProfilerOptions const& options = {});
+
+	Profiler(Profiler const&) = delete;
+
+	Profiler& operator=(Profiler const&) = delete;
+
+	~Profiler();
+
+	/*!
+	 * @brief Installs the signal handler and attaches the calling thread.
+	 *
+	 * @return Whether the profiler was started, false if another profiler is running or
+	 * the platform is not supported.
+	 */
+	bool start();
+
+	void stop();
+
+	[[nodiscard]] bool running() const;
+
+	/*!
+	 * @brief Samples the calling thread until it calls `detach` or the profiler stops.
+	 *
+	 * @return Whether the thread is sampled.
+	 */
+	bool attach();
+
+	void detach();
+
+	[[nodiscard]] ProfilerOptions const& options() const;
+
+	[[nodiscard]] std::size_t numSamples() const;
+
+	/*!
+	 * @brief Samples lost because `capacity` was reached.
+	 */
+	[[nodiscard]] std::size_t numDropped() const;
+
+	/*!
+	 * @brief The sampled scopes and their parents, in depth-first order.
+	 */
+	[[nodiscard]] std::vector<Scope> scopes() const;
+
+	/*!
+	 * @brief Removes the samples.
+	 *
+	 * @note Does nothing while running.
+	 */
+	void clear();
+
+	/*!
+	 * @brief Prints the sampled scopes with their `functions` most sampled functions.
+	 *
+	 * @note A function's percentages are of the samples of its scope, a scope's of all
+	 * samples.
+	 */
+	void print(std::string const& name = "", std::size_t functions = 5) const;
+
+ private:
+	struct Slot {
+		std::atomic<bool> ready{false};
+		Timing const*     scope = nullptr;
+		int               depth = 0;
+	};
+
+	static void handler(int signal, siginfo_t* info, void* context);
+
+	void sample(void* context);
+
+	void pathsRecurs(
+	    Timing const& timing, std::vector<std::string> path,
+	    std::unordered_map<Timing const*, std::vector<std::string>>& paths) const;
+
+	void stopTimers();
+
+ private:
+	Timing const*   timing_;
+	ProfilerOptions options_;
+
+	std::unique_ptr<Slot[]>  slots_;
+	// `stack_depth` frames per slot
+	std::unique_ptr<void*[]> stacks_;
+	std::atomic<std::size_t> next_{0};
+
+	mutable std::mutex                 mutex_;
+	std::map<std::thread::id, timer_t> timers_;
+	bool                               running_ = false;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_PROFILER_HPP
@@ -0,0 +1,191 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_REAL_TIME_TIMING_HPP
+#define UFO_TIME_REAL_TIME_TIMING_HPP
+
+// UFO
+#include <ufo/time/timer.hpp>
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Times real-time threads (e.g., under `SCHED_FIFO`) in the structure of a
+ * `Timing` tree, without allocating or locking while timing.
+ *
+ * The tree is copied when constructed, typically after a warmup phase with the regular
+ * `Timing`, and each thread allocates its state once with `attach`. After that `start`
+ * and `stop` only read the clock and write to memory of the calling thread, so they are
+ * wait-free with a bounded execution time. A tag that is not in the tree is timed in the
+ * `Timing::otherTag()` node of its parent. `flush`, called from a thread that is not
+ * real-time, adds the samples to the `Timing`:
+ *
+ * @code
+ * ufo::Timing         timing;
+ * // Warmup with timing.start/stop
+ * ufo::RealTimeTiming rt(timing, 4);
+ * // In each real-time thread, before its loop
+ * rt.attach();
+ * rt.start("Control");
+ * rt.stop();
+ * // Periodically, in another thread
+ * rt.flush();
+ * timing.printMilliseconds();
+ * @endcode
+ *
+ * @note `timing` must outlive this and its nodes must not be folded by
+ * `Timing::compact` while this exists.
+ */
+class RealTimeTiming
+{
+ public:
+	/*!
+	 * @param timing The tree to time in and to flush the samples to.
+	 * @param max_threads Maximum number of threads that can `attach`.
+	 * @param max_depth Maximum number of nested `start`s per thread, deeper ones are
+	 * counted as overflows and not timed.
+	 */
+	RealTimeTiming(Timing& timing, std::size_t max_threads, std::size_t max_depth = 32);
+
+	RealTimeTiming(RealTimeTiming const&) = delete;
+
+	RealTimeTiming& operator=(RealTimeTiming const&) = delete;
+
+	/*!
+	 * @brief Allocates the state of the calling thread, call before it is real-time.
+	 *
+	 * @note Threads are identified by `std::thread::id`, so a thread that gets the id of
+	 * one that has exited reuses its state.
+	 *
+	 * @return Whether the thread can time, false if `max_threads` threads have attached.
+	 */
+	bool attach();
+
+	/*!
+	 * @brief Starts timing `tag` within the current timing of the calling thread.
+	 *
+	 * @return Whether the calling thread is attached.
+	 */
+	bool start(std::string_view tag);
+
+	bool stop();
+
+	/*!
+	 * @brief Adds the samples taken since the last flush to the `Timing`.
+	 */
+	void flush();
+
+	[[nodiscard]] std::size_t numNodes() const;
+
+	[[nodiscard]] std::size_t numThreads() const;
+
+	/*!
+	 * @brief Number of `start`s with a tag that is not in the tree or too deep.
+	 */
+	[[nodiscard]] std::size_t numOverflows() const;
+
+ private:
+	struct Node {
+		std::string tag;
+		std::size_t parent;
+		// Sorted by tag
+		std::vector<std::pair<std::string, std::size_t>> children;
+		// The node unknown tags are timed in, itself for an overflow node
+		std::size_t other;
+		// nullptr for an overflow node that has not been flushed yet
+		Timing* target;
+	};
+
+	struct Running {
+		std::size_t                                                 node;
+		std::chrono::time_point<std::chrono::high_resolution_clock> start;
+	};
+
+	struct alignas(64) Thread {
+		std::thread::id id;
+		// Odd while the thread updates its timers
+		std::atomic<std::uint32_t> sequence{0};
+		std::atomic<std::size_t>   overflows{0};
+		// One per node
+		std::unique_ptr<Timer[]> timers;
+		// The timers as of the last flush
+		std::unique_ptr<Timer[]>   flushed;
+		std::unique_ptr<Running[]> stack;
+		// May be larger than `max_depth`, the extra levels are not timed
+		std::size_t depth = 0;
+	};
+
+	void addRecurs(Timing& timing, std::size_t parent);
+
+	Thread* thread() const;
+
+	Timing& target(std::size_t node);
+
+ private:
+	std::vector<Node> nodes_;
+	std::size_t       max_depth_;
+	// Identifies this in the cache of the calling thread's state
+	std::uint64_t id_;
+
+	std::unique_ptr<Thread[]> threads_;
+	std::size_t               max_threads_;
+	std::atomic<std::size_t>  num_threads_{0};
+
+	// Serializes `attach` and `flush`
+	std::mutex mutex_;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_REAL_TIME_TIMING_HPP
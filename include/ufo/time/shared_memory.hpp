@@ -0,0 +1,196 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_SHARED_MEMORY_HPP
+#define UFO_TIME_SHARED_MEMORY_HPP
+
+// UFO
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Publishes the statistics of a `Timing` tree in a named POSIX shared memory
+ * segment, where `SharedMemoryReader`s in other processes can read them without
+ * stopping this one.
+ *
+ * The segment is a header followed by a fixed number of node records (parent index,
+ * tag and statistics in nanoseconds, native byte order). A sequence number in the header
+ * is odd while a snapshot is written, so readers copy the nodes and retry if it changed.
+ *
+ * @note The published `Timing` has to outlive the publisher. The segment is removed when
+ * the publisher is destroyed. A name can only be published by one publisher at a time.
+ */
+class SharedMemoryPublisher
+{
+ public:
+	/*!
+	 * @param name Name of the segment, e.g., "ufotime.planner".
+	 * @param capacity Maximum number of nodes, the nodes after that are left out.
+	 *
+	 * @note If a running process already publishes `name` the publisher is not opened, see
+	 * `isOpen`. A segment left behind by a process that has exited is replaced.
+	 */
+	SharedMemoryPublisher(Timing const& timing, std::string const& name,
+	                      std::size_t capacity = 1024);
+
+	SharedMemoryPublisher(SharedMemoryPublisher const&) = delete;
+
+	SharedMemoryPublisher& operator=(SharedMemoryPublisher const&) = delete;
+
+	~SharedMemoryPublisher();
+
+	[[nodiscard]] bool isOpen() const;
+
+	[[nodiscard]] std::string const& name() const;
+
+	/*!
+	 * @brief Writes the current statistics to the segment.
+	 *
+	 * @return Whether the statistics were written.
+	 */
+	bool publish();
+
+	/*!
+	 * @brief Publishes every `interval` from a background thread.
+	 *
+	 * @note Has no effect if the publisher is already publishing periodically.
+	 */
+	void publishPeriodically(std::chrono::milliseconds interval = std::chrono::seconds(1));
+
+	/*!
+	 * @brief Stops the background thread.
+	 */
+	void stop();
+
+ private:
+	struct Header;
+	struct Node;
+
+	void collect(Timing const& node, std::uint32_t parent, std::vector<Node>& nodes,
+	             bool& truncated) const;
+
+ private:
+	Timing const& timing_;
+	std::string   name_;
+	std::size_t   capacity_;
+	int           fd_   = -1;
+	void*         data_ = nullptr;
+	std::size_t   size_ = 0;
+
+	// Only one snapshot is written at a time
+	std::mutex publish_mutex_;
+
+	std::atomic_bool        running_{false};
+	std::mutex              mutex_;
+	std::condition_variable cv_;
+	std::thread             thread_;
+
+	friend class SharedMemoryReader;
+};
+
+/*!
+ * @brief Reads the statistics published by a `SharedMemoryPublisher`, possibly in
+ * another process.
+ */
+class SharedMemoryReader
+{
+ public:
+	explicit SharedMemoryReader(std::string const& name);
+
+	SharedMemoryReader(SharedMemoryReader const&) = delete;
+
+	SharedMemoryReader& operator=(SharedMemoryReader const&) = delete;
+
+	~SharedMemoryReader();
+
+	/*!
+	 * @brief The names of the segments currently published, that start with `prefix`.
+	 */
+	[[nodiscard]] static std::vector<std::string> publishers(
+	    std::string const& prefix = "ufotime.");
+
+	[[nodiscard]] bool isOpen() const;
+
+	/*!
+	 * @brief The process id of the publisher.
+	 */
+	[[nodiscard]] std::int64_t pid() const;
+
+	/*!
+	 * @brief Whether the publishing process is still running. A segment of a process that
+	 * exited without destroying its publisher stays until it is removed or replaced.
+	 */
+	[[nodiscard]] bool alive() const;
+
+	/*!
+	 * @brief The number of snapshots published so far.
+	 */
+	[[nodiscard]] std::uint64_t numPublished() const;
+
+	/*!
+	 * @brief Adds the latest snapshot to `timing`, which takes the place of the root of the
+	 * published tree. Reading several publishers into the same `timing` aggregates them.
+	 *
+	 * @return Whether a consistent snapshot was read.
+	 */
+	bool read(Timing& timing) const;
+
+ private:
+	int                  fd_   = -1;
+	unsigned char const* data_ = nullptr;
+	std::size_t          size_ = 0;
+	std::size_t          capacity_{};
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_SHARED_MEMORY_HPP
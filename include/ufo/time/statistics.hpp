@@ -0,0 +1,120 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_STATISTICS_HPP
+#define UFO_TIME_STATISTICS_HPP
+
+// UFO
+#include <ufo/time/timer.hpp>
+
+// STL
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief The regularized incomplete beta function I_x(a, b).
+ */
+[[nodiscard]] double incompleteBeta(double a, double b, double x);
+
+/*!
+ * @brief The cumulative distribution function of Student's t-distribution with `df`
+ * degrees of freedom.
+ */
+[[nodiscard]] double studentTCdf(double t, double df);
+
+/*!
+ * @brief The inverse of `studentTCdf`, the `t` for which `studentTCdf(t, df) == p`.
+ */
+[[nodiscard]] double studentTQuantile(double p, double df);
+
+struct WelchTTest {
+	// Welch's t statistic, positive if the second mean is larger
+	double t;
+	// Welch–Satterthwaite degrees of freedom
+	double df;
+	// Two-sided p-value
+	double p;
+};
+
+/*!
+ * @brief Welch's unequal variances t-test between two samples, given their mean, sample
+ * variance and number of samples.
+ *
+ * @note All members of the result are NaN if either sample has fewer than two samples.
+ */
+[[nodiscard]] WelchTTest welchTTest(double mean_1, double sample_variance_1, double n_1,
+                                    double mean_2, double sample_variance_2, double n_2);
+
+[[nodiscard]] WelchTTest welchTTest(Timer const& first, Timer const& second);
+
+enum class Complexity { CONSTANT, LOGARITHMIC, LINEAR, LINEARITHMIC, QUADRATIC, CUBIC };
+
+/*!
+ * @brief The big O notation of `complexity`, e.g., "O(n log n)".
+ */
+[[nodiscard]] char const* complexityName(Complexity complexity);
+
+struct ComplexityFit {
+	// Exponent b of the power law t = a n^b, fitted in log-log space
+	double exponent;
+	// The class whose scaled function t = c f(n) fits best
+	Complexity complexity;
+	// The constant c of the best class
+	double coefficient;
+	// Root mean square residual of the best class relative to the mean time
+	double error;
+};
+
+/*!
+ * @brief Fits the empirical complexity of the times `seconds` measured at the problem
+ * sizes `sizes`, each weighted by the corresponding element of `weights` (e.g., the
+ * number of samples the time is the mean of).
+ *
+ * @note All members of the result except `complexity` are NaN if there are fewer than
+ * two distinct positive sizes with positive times.
+ */
+[[nodiscard]] ComplexityFit fitComplexity(std::vector<double> const& sizes,
+                                          std::vector<double> const& seconds,
+                                          std::vector<double> const& weights = {});
+}  // namespace ufo
+
+#endif  // UFO_TIME_STATISTICS_HPP
@@ -0,0 +1,145 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_TIME_SERIES_HPP
+#define UFO_TIME_TIME_SERIES_HPP
+
+// UFO
+#include <ufo/time/histogram.hpp>
+#include <ufo/time/timer.hpp>
+
+// STL
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Statistics of durations per fixed interval of time, at several resolutions,
+ * e.g., per second for the last minutes and per minute for the last hours.
+ *
+ * Each resolution is a ring of intervals, so the number of intervals is fixed and the
+ * oldest is overwritten. Periodic stalls (e.g., a compaction every 30 s) that disappear
+ * in the aggregates of a whole run show up as spikes in the series.
+ */
+class TimeSeries
+{
+ public:
+	struct Resolution {
+		std::chrono::high_resolution_clock::duration interval;
+		// Number of intervals kept
+		std::size_t num;
+	};
+
+	struct Interval {
+		// Wall clock time when the interval started
+		std::chrono::system_clock::time_point start;
+		Timer                                 timer;
+		Histogram                             histogram;
+	};
+
+	/*!
+	 * @brief Per second for the last five minutes and per minute for the last four hours.
+	 */
+	[[nodiscard]] static std::vector<Resolution> defaultResolutions();
+
+	/*!
+	 * @note Resolutions without intervals or with a non-positive interval are ignored.
+	 */
+	explicit TimeSeries(std::vector<Resolution> const& resolutions = defaultResolutions());
+
+	/*!
+	 * @brief Adds a sample to the interval of each resolution that contains `stop`.
+	 *
+	 * @note A sample older than the intervals kept by a resolution is ignored by it.
+	 */
+	void add(std::chrono::time_point<std::chrono::high_resolution_clock> start,
+	         std::chrono::time_point<std::chrono::high_resolution_clock> stop);
+
+	void reset();
+
+	[[nodiscard]] std::size_t numResolutions() const;
+
+	[[nodiscard]] Resolution resolution(std::size_t index) const;
+
+	/*!
+	 * @brief The intervals of resolution `index` up to the latest one with a sample,
+	 * oldest first. Intervals without samples are included, so they are equally spaced.
+	 */
+	[[nodiscard]] std::vector<Interval> intervals(std::size_t index = 0) const;
+
+	/*!
+	 * @brief Writes all resolutions as JSON, with times in seconds and the start of the
+	 * intervals in seconds since the Unix epoch.
+	 *
+	 * @note Each interval has the samples, mean, max, p50, p90, p99 and the non-empty
+	 * histogram buckets as [lower, upper, count], which is the data of a latency heatmap.
+	 */
+	void writeJson(std::ostream& out) const;
+
+	/*!
+	 * @brief Estimated number of bytes used.
+	 */
+	[[nodiscard]] std::size_t memoryUsage() const;
+
+ private:
+	struct Slot {
+		// Index of the interval since the clock's epoch, -1 if unused
+		std::int64_t index = -1;
+		Timer        timer;
+		Histogram    histogram;
+	};
+
+	struct Ring {
+		Resolution        resolution;
+		std::vector<Slot> slots;
+		std::int64_t      latest = -1;
+	};
+
+ private:
+	std::vector<Ring> rings_;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_TIME_SERIES_HPP
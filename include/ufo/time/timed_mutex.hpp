@@ -0,0 +1,376 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_TIMED_MUTEX_HPP
+#define UFO_TIME_TIMED_MUTEX_HPP
+
+// UFO
+#include <ufo/time/timer.hpp>
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+
+namespace ufo
+{
+struct LockStats {
+	// Acquisitions that did not have to wait
+	std::uint64_t uncontended        = 0;
+	std::uint64_t contended          = 0;
+	std::uint64_t shared_uncontended = 0;
+	std::uint64_t shared_contended   = 0;
+
+	// Time blocked before acquiring, of the contended acquisitions
+	Timer wait;
+	Timer shared_wait;
+
+	// Time held, of the contended acquisitions and of a sample of the uncontended ones
+	Timer hold_contended;
+	Timer hold_uncontended;
+};
+
+/*!
+ * @brief The statistics shared by the timed locks.
+ *
+ * An uncontended acquisition costs a try-lock and the increment of a counter that is
+ * protected by the lock itself, only contended acquisitions read the clock.
+ *
+ * The hold time of uncontended acquisitions is not measured by default. With a non-zero
+ * `hold_sample_period`, every `hold_sample_period`th uncontended acquisition reads the
+ * clock when locking and unlocking, and adds the sample under an internal mutex.
+ *
+ * If a `Timing` is given, the samples are also added to its children "Contended wait",
+ * "Shared wait", "Contended hold" and "Uncontended hold", so they show up next to the
+ * time spent working.
+ */
+class TimedLockable
+{
+ public:
+	virtual ~TimedLockable() = default;
+
+	/*!
+	 * @note Briefly locks the underlying mutex to read the uncontended count, so it must
+	 * not be called while holding the lock exclusively.
+	 */
+	[[nodiscard]] LockStats stats() const;
+
+	void resetStats();
+
+ protected:
+	explicit TimedLockable(std::size_t hold_sample_period);
+
+	TimedLockable(Timing& timing, std::size_t hold_sample_period);
+
+	// Whether the hold time of an uncontended acquisition should be measured
+	[[nodiscard]] bool sampleHold(std::size_t n) const
+	{
+		return 0 != hold_sample_period_ && 0 == n % hold_sample_period_;
+	}
+
+	void addWait(std::chrono::time_point<std::chrono::high_resolution_clock> start,
+	             std::chrono::time_point<std::chrono::high_resolution_clock> stop,
+	             bool                                                        shared);
+
+	void addHold(std::chrono::time_point<std::chrono::high_resolution_clock> start,
+	             std::chrono::time_point<std::chrono::high_resolution_clock> stop,
+	             bool                                                        contended);
+
+	// Locks the underlying mutex without recording the acquisition
+	virtual void lockQuietly() const = 0;
+
+	virtual void unlockQuietly() const = 0;
+
+ protected:
+	// Only modified by the exclusive owner
+	std::size_t uncontended_ = 0;
+	// Shared owners increment it concurrently
+	std::atomic<std::uint64_t> shared_uncontended_{0};
+
+	// Set by the exclusive owner, zero if the hold is not measured
+	std::chrono::time_point<std::chrono::high_resolution_clock> hold_start_{};
+	bool                                                        hold_contended_ = false;
+
+ private:
+	std::size_t hold_sample_period_;
+
+	mutable std::mutex stats_mutex_;
+	LockStats          stats_;
+
+	Timing* wait_timing_             = nullptr;
+	Timing* shared_wait_timing_      = nullptr;
+	Timing* hold_contended_timing_   = nullptr;
+	Timing* hold_uncontended_timing_ = nullptr;
+};
+
+/*!
+ * @brief Drop-in replacement for `std::mutex` that records wait and hold times.
+ */
+class TimedMutex : public TimedLockable
+{
+ public:
+	explicit TimedMutex(std::size_t hold_sample_period = 0);
+
+	explicit TimedMutex(Timing& timing, std::size_t hold_sample_period = 0);
+
+	TimedMutex(TimedMutex const&) = delete;
+
+	TimedMutex& operator=(TimedMutex const&) = delete;
+
+	void lock()
+	{
+		if (mutex_.try_lock()) {
+			locked(uncontended_++);
+		} else {
+			lockContended();
+		}
+	}
+
+	[[nodiscard]] bool try_lock()
+	{
+		if (!mutex_.try_lock()) {
+			return false;
+		}
+		locked(uncontended_++);
+		return true;
+	}
+
+	void unlock();
+
+ private:
+	void locked(std::size_t n)
+	{
+		hold_start_ = sampleHold(n) ? std::chrono::high_resolution_clock::now()
+		                            : decltype(hold_start_){};
+		hold_contended_ = false;
+	}
+
+	void lockContended();
+
+	void lockQuietly() const override;
+
+	void unlockQuietly() const override;
+
+ private:
+	mutable std::mutex mutex_;
+};
+
+/*!
+ * @brief Drop-in replacement for `std::shared_mutex` that records wait and hold times.
+ *
+ * @note Only the hold time of exclusive ownership is recorded.
+ */
+class TimedSharedMutex : public TimedLockable
+{
+ public:
+	explicit TimedSharedMutex(std::size_t hold_sample_period = 0);
+
+	explicit TimedSharedMutex(Timing& timing, std::size_t hold_sample_period = 0);
+
+	TimedSharedMutex(TimedSharedMutex const&) = delete;
+
+	TimedSharedMutex& operator=(TimedSharedMutex const&) = delete;
+
+	void lock()
+	{
+		if (mutex_.try_lock()) {
+			locked(uncontended_++);
+		} else {
+			lockContended();
+		}
+	}
+
+	[[nodiscard]] bool try_lock()
+	{
+		if (!mutex_.try_lock()) {
+			return false;
+		}
+		locked(uncontended_++);
+		return true;
+	}
+
+	void unlock();
+
+	void lock_shared()
+	{
+		if (mutex_.try_lock_shared()) {
+			shared_uncontended_.fetch_add(1, std::memory_order_relaxed);
+		} else {
+			lockSharedContended();
+		}
+	}
+
+	[[nodiscard]] bool try_lock_shared()
+	{
+		if (!mutex_.try_lock_shared()) {
+			return false;
+		}
+		shared_uncontended_.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	void unlock_shared() { mutex_.unlock_shared(); }
+
+ private:
+	void locked(std::size_t n)
+	{
+		hold_start_ = sampleHold(n) ? std::chrono::high_resolution_clock::now()
+		                            : decltype(hold_start_){};
+		hold_contended_ = false;
+	}
+
+	void lockContended();
+
+	void lockSharedContended();
+
+	void lockQuietly() const override;
+
+	void unlockQuietly() const override;
+
+ private:
+	mutable std::shared_mutex mutex_;
+};
+
+/*!
+ * @brief Drop-in replacement for `std::condition_variable` that records the time spent
+ * waiting, works with any lock (e.g., `std::unique_lock<TimedMutex>`).
+ *
+ * If a `Timing` is given, the waits are also added to its child "Condition wait".
+ */
+class TimedConditionVariable
+{
+ public:
+	TimedConditionVariable() = default;
+
+	explicit TimedConditionVariable(Timing& timing);
+
+	TimedConditionVariable(TimedConditionVariable const&) = delete;
+
+	TimedConditionVariable& operator=(TimedConditionVariable const&) = delete;
+
+	void notify_one() noexcept;
+
+	void notify_all() noexcept;
+
+	template <class Lock>
+	void wait(Lock& lock)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		cv_.wait(lock);
+		addWait(start, std::chrono::high_resolution_clock::now(), false);
+	}
+
+	template <class Lock, class Predicate>
+	void wait(Lock& lock, Predicate pred)
+	{
+		while (!pred()) {
+			wait(lock);
+		}
+	}
+
+	template <class Lock, class Clock, class Duration>
+	std::cv_status wait_until(Lock&                                           lock,
+	                          std::chrono::time_point<Clock, Duration> const& abs_time)
+	{
+		auto start  = std::chrono::high_resolution_clock::now();
+		auto status = cv_.wait_until(lock, abs_time);
+		addWait(start, std::chrono::high_resolution_clock::now(),
+		        std::cv_status::timeout == status);
+		return status;
+	}
+
+	template <class Lock, class Clock, class Duration, class Predicate>
+	bool wait_until(Lock& lock, std::chrono::time_point<Clock, Duration> const& abs_time,
+	                Predicate pred)
+	{
+		while (!pred()) {
+			if (std::cv_status::timeout == wait_until(lock, abs_time)) {
+				return pred();
+			}
+		}
+		return true;
+	}
+
+	template <class Lock, class Rep, class Period>
+	std::cv_status wait_for(Lock& lock, std::chrono::duration<Rep, Period> const& rel_time)
+	{
+		return wait_until(lock, std::chrono::steady_clock::now() + rel_time);
+	}
+
+	template <class Lock, class Rep, class Period, class Predicate>
+	bool wait_for(Lock& lock, std::chrono::duration<Rep, Period> const& rel_time,
+	              Predicate pred)
+	{
+		return wait_until(lock, std::chrono::steady_clock::now() + rel_time,
+		                  std::move(pred));
+	}
+
+	/*!
+	 * @brief The time spent in each wait, including the ones that timed out.
+	 */
+	[[nodiscard]] Timer waitTimer() const;
+
+	[[nodiscard]] std::uint64_t timeouts() const;
+
+	void resetStats();
+
+ private:
+	void addWait(std::chrono::time_point<std::chrono::high_resolution_clock> start,
+	             std::chrono::time_point<std::chrono::high_resolution_clock> stop,
+	             bool                                                        timeout);
+
+ private:
+	std::condition_variable_any cv_;
+
+	mutable std::mutex stats_mutex_;
+	Timer              wait_;
+	std::uint64_t      timeouts_ = 0;
+
+	Timing* timing_ = nullptr;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_TIMED_MUTEX_HPP
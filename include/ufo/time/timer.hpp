@@ -42,26 +42,120 @@
 #ifndef UFO_TIME_TIMER_HPP
 #define UFO_TIME_TIMER_HPP
 
+// UFO
+#include <ufo/time/probes.hpp>
+
 // STL
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 namespace ufo
 {
+/*!
+ * @note The functions used while timing (`start`, `stop`, `pause`, `resume`, `running`,
+ * `addSample`, ...) are defined in this header so they can be inlined, their overhead is
+ * otherwise a noticeable part of timing short regions.
+ */
 class Timer
 {
  public:
-	void start();
+	void start() { start(std::chrono::high_resolution_clock::now()); }
 
-	void pause();
+	void pause()
+	{
+		current_ += std::chrono::high_resolution_clock::now() - start_;
+		start_ = {};
+	}
 
-	void resume();
+	void resume() { start(); }
 
 	void reset();
 
-	void resetCurrent();
+	void resetCurrent()
+	{
+		start_   = {};
+		current_ = std::chrono::high_resolution_clock::duration::zero();
+	}
+
+	void stop() { stop(std::chrono::high_resolution_clock::now()); }
+
+	/*!
+	 * @brief Adds a sample that was measured elsewhere.
+	 */
+	void addSample(std::chrono::time_point<std::chrono::high_resolution_clock> start,
+	               std::chrono::time_point<std::chrono::high_resolution_clock> stop)
+	{
+		auto elapsed = stop - start;
+
+		if (last_time_point_ < stop) {
+			last_time_point_ = stop;
+			last_            = elapsed;
+		}
 
-	void stop();
+		addElapsed(elapsed);
+	}
+
+	/*!
+	 * @brief Adds `count` samples at once, e.g., latencies recorded in a log or a replay.
+	 *
+	 * @note Gives the same statistics as adding the samples one by one, but processes
+	 * them in vectorized blocks.
+	 *
+	 * @note The durations have no stop time, so the last sample is not changed. Use the
+	 * overload with start and stop times to set it.
+	 *
+	 * @param samples The durations of the samples.
+	 * @param count The number of samples.
+	 */
+	void addSamples(std::chrono::high_resolution_clock::duration const* samples,
+	                std::size_t                                         count);
+
+	/*!
+	 * @brief Adds `count` samples at once, each given by its start and stop time.
+	 *
+	 * @param samples The start and stop time of the samples.
+	 * @param count The number of samples.
+	 */
+	void addSamples(
+	    std::pair<std::chrono::time_point<std::chrono::high_resolution_clock>,
+	              std::chrono::time_point<std::chrono::high_resolution_clock>> const* samples,
+	    std::size_t                                                                  count);
+
+	/*!
+	 * @brief Adds the samples in [first, last), either durations or pairs of start and
+	 * stop time.
+	 */
+	template <class InputIt>
+	void addSamples(InputIt first, InputIt last)
+	{
+		using T = typename std::iterator_traits<InputIt>::value_type;
+		using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+		constexpr bool is_pair = std::is_convertible_v<T, std::pair<TimePoint, TimePoint>>;
+		using Buffer =
+		    std::conditional_t<is_pair, std::pair<TimePoint, TimePoint>,
+		                       std::chrono::high_resolution_clock::duration>;
+
+		std::array<Buffer, 1024> buffer;
+		while (first != last) {
+			std::size_t n{};
+			for (; buffer.size() > n && first != last; ++n, ++first) {
+				if constexpr (is_pair) {
+					buffer[n] = *first;
+				} else {
+					buffer[n] = std::chrono::duration_cast<
+					    std::chrono::high_resolution_clock::duration>(*first);
+				}
+			}
+			addSamples(buffer.data(), n);
+		}
+	}
 
 	/*!
 	 * @brief
@@ -85,7 +179,12 @@ class Timer
 	friend Timer operator+(Timer lhs, Timer rhs);
 
 	/*!
-	 * @brief
+	 * @brief Removes the samples of `rhs`, which has to be an earlier state of this timer
+	 * (e.g., a copy taken at the start of an interval). What is left are the exact
+	 * statistics of the samples added since.
+	 *
+	 * @note The minimum and maximum are NaN if they cannot be told apart from those of
+	 * `rhs`.
 	 *
 	 * @note This will stop the `rhs` timer (if it is running or paused) to add another
 	 * sample.
@@ -106,9 +205,15 @@ class Timer
 	 */
 	friend Timer operator-(Timer lhs, Timer rhs);
 
-	[[nodiscard]] bool running() const;
+	[[nodiscard]] bool running() const
+	{
+		return std::chrono::time_point<std::chrono::high_resolution_clock>{} != start_;
+	}
 
-	[[nodiscard]] bool paused() const;
+	[[nodiscard]] bool paused() const
+	{
+		return !running() && std::chrono::high_resolution_clock::duration::zero() != current_;
+	}
 
 	template <class Period = std::chrono::seconds::period>
 	[[nodiscard]] double current() const
@@ -157,8 +262,10 @@ class Timer
 	template <class Period = std::chrono::seconds::period>
 	[[nodiscard]] double min() const
 	{
-		return 0 < numSamples() ? toDouble<Period>(min_)
-		                        : std::numeric_limits<double>::quiet_NaN();
+		return 0 < numSamples() &&
+		               std::chrono::high_resolution_clock::duration::max() != min_
+		           ? toDouble<Period>(min_)
+		           : std::numeric_limits<double>::quiet_NaN();
 	}
 
 	[[nodiscard]] double minSeconds() const;
@@ -172,8 +279,10 @@ class Timer
 	template <class Period = std::chrono::seconds::period>
 	[[nodiscard]] double max() const
 	{
-		return 0 < numSamples() ? toDouble<Period>(max_)
-		                        : std::numeric_limits<double>::quiet_NaN();
+		return 0 < numSamples() &&
+		               std::chrono::high_resolution_clock::duration::min() != max_
+		           ? toDouble<Period>(max_)
+		           : std::numeric_limits<double>::quiet_NaN();
 	}
 
 	[[nodiscard]] double maxSeconds() const;
@@ -262,15 +371,28 @@ class Timer
 
 	[[nodiscard]] double populationVarianceNanoseconds() const;
 
-	[[nodiscard]] int numSamples() const;
+	[[nodiscard]] int numSamples() const { return samples_; }
 
  protected:
-	void start(std::chrono::time_point<std::chrono::high_resolution_clock> time);
+	void start(std::chrono::time_point<std::chrono::high_resolution_clock> time)
+	{
+		start_ = time;
+	}
 
-	void stop(std::chrono::time_point<std::chrono::high_resolution_clock> time);
+	void stop(std::chrono::time_point<std::chrono::high_resolution_clock> time)
+	{
+		last_time_point_ = time;
 
-	void addSample(std::chrono::time_point<std::chrono::high_resolution_clock> start,
-	               std::chrono::time_point<std::chrono::high_resolution_clock> stop);
+		last_ = paused() ? current_ : current_ + (time - start_);
+
+		start_   = {};
+		current_ = std::chrono::high_resolution_clock::duration::zero();
+
+		addElapsed(last_);
+
+		UFOTIME_PROBE2(timer__stop, this,
+		               std::chrono::duration_cast<std::chrono::nanoseconds>(last_).count());
+	}
 
  private:
 	template <class Period, class Duration>
@@ -279,6 +401,33 @@ class Timer
 		return std::chrono::duration<double, Period>(dur).count();
 	}
 
+	// Welford's update of the statistics
+	void addElapsed(std::chrono::high_resolution_clock::duration elapsed)
+	{
+		++samples_;
+
+		auto delta_1 = std::chrono::duration<double>(elapsed - mean_);
+		mean_ += delta_1 / samples_;
+		auto delta_2 = std::chrono::duration<double>(elapsed - mean_);
+		sum_squares_diffs_ += toDouble<std::chrono::seconds::period>(delta_1) *
+		                      toDouble<std::chrono::seconds::period>(delta_2);
+
+		total_ += elapsed;
+		min_ = std::min(min_, elapsed);
+		max_ = std::max(max_, elapsed);
+	}
+
+	/*!
+	 * @brief Combines the statistics of another set of samples with these (Chan et al.),
+	 * `sum_squares_diffs` is in seconds squared.
+	 */
+	void combine(int samples, std::chrono::high_resolution_clock::duration total,
+	             std::chrono::duration<double, std::chrono::high_resolution_clock::period>
+	                                                          mean,
+	             double                                       sum_squares_diffs,
+	             std::chrono::high_resolution_clock::duration min,
+	             std::chrono::high_resolution_clock::duration max);
+
  protected:
 	std::chrono::time_point<std::chrono::high_resolution_clock> start_ = {};
 	// Used for pause/resume
@@ -300,7 +449,11 @@ class Timer
 	std::chrono::high_resolution_clock::duration max_ =
 	    std::chrono::high_resolution_clock::duration::min();
 
+	friend class SharedMemoryPublisher;
+	friend class SharedMemoryReader;
 	friend class Timing;
+	template <class, class, class>
+	friend class TimerTable;
 };
 }  // namespace ufo
 
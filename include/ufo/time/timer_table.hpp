@@ -0,0 +1,390 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_TIMER_TABLE_HPP
+#define UFO_TIME_TIMER_TABLE_HPP
+
+// UFO
+#include <ufo/time/timer.hpp>
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Timing statistics for a large number of keys, e.g., per octree depth and node
+ * type or per map chunk.
+ *
+ * Each key takes the count, total, min and max of its samples plus the sum of squared
+ * differences, stored as structure-of-arrays in open-addressing hash tables. The keys
+ * are split over shards with a mutex each, so threads updating different keys rarely
+ * contend. Queries return `Timer`s, with the same statistics as adding the samples to a
+ * `Timer` (except for the last sample, which is not kept).
+ *
+ * @note `Key` has to be default constructible.
+ */
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class TimerTable
+{
+ public:
+	// What to order the keys by in `topK`
+	enum class By { TOTAL, MEAN, MAX, SAMPLES };
+
+	explicit TimerTable(std::size_t num_shards = 16) : shards_(roundUp(num_shards))
+	{
+		for (std::size_t i = shards_.size(); 1 < i; i >>= 1) {
+			++shard_bits_;
+		}
+	}
+
+	void add(Key const& key, std::chrono::high_resolution_clock::duration duration)
+	{
+		auto  h = hash(key);
+		auto& s = shards_[shard(h)];
+
+		std::lock_guard lock(s.mutex);
+		auto            i = s.findOrInsert(key, h);
+
+		Rep    v = duration.count();
+		auto   n = ++s.count[i];
+		double x = static_cast<double>(v);
+		// The mean is derived from the exact total, no need to store it
+		double mean_old = 1 == n ? 0.0 : static_cast<double>(s.total[i]) / (n - 1);
+		s.total[i] += v;
+		double mean_new = static_cast<double>(s.total[i]) / n;
+		s.sum_squares_diffs[i] += (x - mean_old) * (x - mean_new);
+		s.min[i] = std::min(s.min[i], v);
+		s.max[i] = std::max(s.max[i], v);
+	}
+
+	void add(Key const&                                                  key,
+	         std::chrono::time_point<std::chrono::high_resolution_clock> start,
+	         std::chrono::time_point<std::chrono::high_resolution_clock> stop)
+	{
+		add(key, stop - start);
+	}
+
+	[[nodiscard]] bool contains(Key const& key) const
+	{
+		auto        h = hash(key);
+		auto const& s = shards_[shard(h)];
+
+		std::lock_guard lock(s.mutex);
+		return s.capacity() != s.find(key, h);
+	}
+
+	/*!
+	 * @brief The statistics of `key`, an empty timer if `key` has no samples.
+	 */
+	[[nodiscard]] Timer timer(Key const& key) const
+	{
+		auto        h = hash(key);
+		auto const& s = shards_[shard(h)];
+
+		std::lock_guard lock(s.mutex);
+		auto            i = s.find(key, h);
+		return s.capacity() == i ? Timer{} : s.timer(i);
+	}
+
+	[[nodiscard]] std::size_t size() const
+	{
+		std::size_t res{};
+		for (auto const& s : shards_) {
+			std::lock_guard lock(s.mutex);
+			res += s.size;
+		}
+		return res;
+	}
+
+	[[nodiscard]] bool empty() const { return 0 == size(); }
+
+	void clear()
+	{
+		for (auto& s : shards_) {
+			std::lock_guard lock(s.mutex);
+			s = Shard{};
+		}
+	}
+
+	/*!
+	 * @brief Calls `f(key, timer)` for each key, in no particular order.
+	 *
+	 * @note The shard of the key is locked during the call.
+	 */
+	template <class F>
+	void forEach(F f) const
+	{
+		for (auto const& s : shards_) {
+			std::lock_guard lock(s.mutex);
+			for (std::size_t i{}; s.capacity() > i; ++i) {
+				if (0 < s.count[i]) {
+					f(s.keys[i], s.timer(i));
+				}
+			}
+		}
+	}
+
+	/*!
+	 * @brief The `k` keys with the largest `by`, largest first.
+	 */
+	[[nodiscard]] std::vector<std::pair<Key, Timer>> topK(std::size_t k,
+	                                                      By          by = By::TOTAL) const
+	{
+		auto value = [by](Timer const& t) -> double {
+			switch (by) {
+				case By::TOTAL: return t.total();
+				case By::MEAN: return t.mean();
+				case By::MAX: return t.max();
+				case By::SAMPLES: return t.numSamples();
+			}
+			return 0.0;
+		};
+		auto cmp = [&value](auto const& a, auto const& b) {
+			return value(a.second) > value(b.second);
+		};
+
+		// Min-heap of the `k` largest so far
+		std::vector<std::pair<Key, Timer>> res;
+		if (0 == k) {
+			return res;
+		}
+		forEach([&](Key const& key, Timer const& t) {
+			if (res.size() < k) {
+				res.emplace_back(key, t);
+				std::push_heap(std::begin(res), std::end(res), cmp);
+			} else if (value(res.front().second) < value(t)) {
+				std::pop_heap(std::begin(res), std::end(res), cmp);
+				res.back() = {key, t};
+				std::push_heap(std::begin(res), std::end(res), cmp);
+			}
+		});
+		std::sort_heap(std::begin(res), std::end(res), cmp);
+		return res;
+	}
+
+	/*!
+	 * @brief The statistics of all samples, as if they had been added to one timer.
+	 */
+	[[nodiscard]] Timer aggregate() const
+	{
+		return aggregate([](Key const&) { return true; });
+	}
+
+	/*!
+	 * @brief The statistics of the samples of the keys for which `pred(key)` is true.
+	 */
+	template <class UnaryPredicate>
+	[[nodiscard]] Timer aggregate(UnaryPredicate pred) const
+	{
+		Timer res;
+		forEach([&](Key const& key, Timer const& t) {
+			if (pred(key)) {
+				res += t;
+			}
+		});
+		return res;
+	}
+
+ private:
+	using Rep = std::chrono::high_resolution_clock::rep;
+
+	struct Shard {
+		mutable std::mutex mutex;
+
+		std::size_t size = 0;
+
+		std::vector<Key>           keys;
+		std::vector<std::uint32_t> count;  // Zero marks an empty slot
+		std::vector<Rep>           total;
+		std::vector<Rep>           min;
+		std::vector<Rep>           max;
+		// In ticks squared
+		std::vector<double> sum_squares_diffs;
+
+		Shard() = default;
+
+		Shard& operator=(Shard&& rhs)
+		{
+			size              = rhs.size;
+			keys              = std::move(rhs.keys);
+			count             = std::move(rhs.count);
+			total             = std::move(rhs.total);
+			min               = std::move(rhs.min);
+			max               = std::move(rhs.max);
+			sum_squares_diffs = std::move(rhs.sum_squares_diffs);
+			return *this;
+		}
+
+		[[nodiscard]] std::size_t capacity() const { return count.size(); }
+
+		// Returns `capacity()` if `key` is not found
+		[[nodiscard]] std::size_t find(Key const& key, std::size_t h) const
+		{
+			if (0 == capacity()) {
+				return 0;
+			}
+
+			std::size_t mask = capacity() - 1;
+			for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+				if (0 == count[i]) {
+					return capacity();
+				} else if (KeyEqual{}(keys[i], key)) {
+					return i;
+				}
+			}
+		}
+
+		std::size_t findOrInsert(Key const& key, std::size_t h)
+		{
+			// Keep the load factor below 3/4
+			if (4 * (size + 1) > 3 * capacity()) {
+				rehash(std::max(std::size_t(16), 2 * capacity()));
+			}
+
+			std::size_t mask = capacity() - 1;
+			std::size_t i    = h & mask;
+			for (; 0 != count[i]; i = (i + 1) & mask) {
+				if (KeyEqual{}(keys[i], key)) {
+					return i;
+				}
+			}
+
+			++size;
+			keys[i]              = key;
+			total[i]             = 0;
+			min[i]               = std::numeric_limits<Rep>::max();
+			max[i]               = std::numeric_limits<Rep>::lowest();
+			sum_squares_diffs[i] = 0.0;
+			return i;
+		}
+
+		void rehash(std::size_t capacity)
+		{
+			Shard old;
+			old = std::move(*this);
+
+			keys.assign(capacity, Key{});
+			count.assign(capacity, 0);
+			total.assign(capacity, 0);
+			min.assign(capacity, 0);
+			max.assign(capacity, 0);
+			sum_squares_diffs.assign(capacity, 0.0);
+
+			std::size_t mask = capacity - 1;
+			for (std::size_t j{}; old.capacity() > j; ++j) {
+				if (0 == old.count[j]) {
+					continue;
+				}
+
+				std::size_t i = TimerTable::hash(old.keys[j]) & mask;
+				while (0 != count[i]) {
+					i = (i + 1) & mask;
+				}
+				keys[i]              = std::move(old.keys[j]);
+				count[i]             = old.count[j];
+				total[i]             = old.total[j];
+				min[i]               = old.min[j];
+				max[i]               = old.max[j];
+				sum_squares_diffs[i] = old.sum_squares_diffs[j];
+			}
+		}
+
+		[[nodiscard]] Timer timer(std::size_t i) const
+		{
+			constexpr double s =
+			    static_cast<double>(std::chrono::high_resolution_clock::period::num) /
+			    static_cast<double>(std::chrono::high_resolution_clock::period::den);
+
+			Timer t;
+			t.samples_           = static_cast<int>(count[i]);
+			t.total_             = std::chrono::high_resolution_clock::duration(total[i]);
+			t.mean_              = t.total_ / static_cast<double>(count[i]);
+			t.sum_squares_diffs_ = sum_squares_diffs[i] * s * s;
+			t.min_               = std::chrono::high_resolution_clock::duration(min[i]);
+			t.max_               = std::chrono::high_resolution_clock::duration(max[i]);
+			return t;
+		}
+	};
+
+	[[nodiscard]] static std::size_t roundUp(std::size_t n)
+	{
+		std::size_t res = 1;
+		while (res < n) {
+			res <<= 1;
+		}
+		return res;
+	}
+
+	// Spreads the bits, `std::hash` is often the identity for integers. Every bit of the
+	// key affects every bit of the result (the splitmix64 finalizer), so keys that only
+	// differ in their high bits (e.g., `id << 16` or pointers) do not share low bits.
+	[[nodiscard]] static std::size_t hash(Key const& key)
+	{
+		auto h = static_cast<std::uint64_t>(Hash{}(key));
+		h      = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+		h      = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+		return static_cast<std::size_t>(h ^ (h >> 31));
+	}
+
+	[[nodiscard]] std::size_t shard(std::size_t h) const
+	{
+		// The high bits pick the shard, the low bits the slot within it
+		return 0 == shard_bits_
+		           ? 0
+		           : h >> (std::numeric_limits<std::size_t>::digits - shard_bits_);
+	}
+
+ private:
+	std::vector<Shard> shards_;
+	int                shard_bits_ = 0;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_TIMER_TABLE_HPP
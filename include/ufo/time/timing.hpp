@@ -43,10 +43,16 @@
 #define UFO_TIME_TIMING_HPP
 
 // UFO
+#include <ufo/time/histogram.hpp>
+#include <ufo/time/statistics.hpp>
+#include <ufo/time/time_series.hpp>
 #include <ufo/time/timer.hpp>
 
 // STL
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <codecvt>
 #include <cstdlib>
 #include <functional>
@@ -55,6 +61,7 @@
 #include <list>
 #include <locale>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <numeric>
 #include <set>
@@ -66,11 +73,49 @@
 
 namespace ufo
 {
+class Journal;
+
 class Timing
 {
 	using Mutex = std::mutex;
 
  public:
+	/*!
+	 * @brief Called when a sample exceeds the budget, with the duration of the sample and
+	 * the tags from the root to the timing that was stopped.
+	 */
+	using BudgetCallback = std::function<void(std::chrono::high_resolution_clock::duration,
+	                                          std::vector<std::string> const&)>;
+
+	struct Frame {
+		std::size_t                                                 index;
+		std::chrono::time_point<std::chrono::high_resolution_clock> start;
+		std::chrono::high_resolution_clock::duration                period;
+		// Time spent in each child during the frame
+		std::vector<std::pair<std::string, std::chrono::high_resolution_clock::duration>>
+		    children;
+
+		// The child that took the longest during the frame, empty if none
+		[[nodiscard]] std::string dominant() const;
+	};
+
+	struct Sample {
+		std::chrono::high_resolution_clock::duration duration;
+		// Wall clock time when the sample started, for correlation with logs
+		std::chrono::system_clock::time_point start;
+		std::thread::id                       thread;
+		// Tags from the root to the timing, i.e., the enclosing scopes
+		std::vector<std::string> path;
+	};
+
+	struct SizeBucket {
+		// The samples with a size in [min_size, max_size]
+		std::size_t min_size;
+		std::size_t max_size;
+		double      mean_size;
+		Timer       timer;
+	};
+
 	Timing(std::string const& tag = "Total", char const* color = "");
 
 	Timing(char const* tag, char const* color = "");
@@ -116,10 +161,39 @@ class Timing
 
 	bool stop();
 
+	/*!
+	 * @brief Stops the current timing of this thread and adds `work` (e.g., number of
+	 * points integrated or bytes read) to its work counters.
+	 *
+	 * @note The work counters are printed as throughput (per second) and time per item,
+	 * over the time of the samples that added to the counter, see `workSeconds`.
+	 */
+	bool stop(std::initializer_list<std::pair<std::string const, double>> work);
+
+	/*!
+	 * @brief Stops the current timing of this thread and records the sample together with
+	 * the problem size `size` (e.g., number of points in a scan or nodes touched).
+	 *
+	 * @note The samples are bucketed by the power of two of their size, see `sizeBuckets`.
+	 */
+	bool stopWithSize(
+	    std::size_t                                                 size,
+	    std::initializer_list<std::pair<std::string const, double>> work = {});
+
 	std::size_t stop(std::size_t levels);
 
 	void stopAll();
 
+	/*!
+	 * @brief Adds a sample that was measured elsewhere, e.g., by a `TimedMutex`.
+	 */
+	void addSample(std::chrono::time_point<std::chrono::high_resolution_clock> start,
+	               std::chrono::time_point<std::chrono::high_resolution_clock> stop);
+
+	void addSample(std::chrono::time_point<std::chrono::high_resolution_clock> start,
+	               std::chrono::time_point<std::chrono::high_resolution_clock> stop,
+	               std::size_t                                                 size);
+
 	Timing const& operator[](std::string const& tag) const;
 
 	Timing& operator[](std::string const& tag);
@@ -156,6 +230,493 @@ class Timing
 
 	std::string const& tag() const;
 
+	/*!
+	 * @brief The statistics of this timing.
+	 */
+	[[nodiscard]] Timer timer() const;
+
+	[[nodiscard]] std::map<std::string, double> work() const;
+
+	/*!
+	 * @brief The total time, in seconds, of the samples that added to each work counter.
+	 */
+	[[nodiscard]] std::map<std::string, double> workSeconds() const;
+
+	/*!
+	 * @brief The samples recorded with a size, bucketed by the power of two of the size,
+	 * smallest first. Only buckets with samples are returned.
+	 */
+	[[nodiscard]] std::vector<SizeBucket> sizeBuckets() const;
+
+	/*!
+	 * @brief How the time of this timing scales with the size, fitted to the mean time and
+	 * size of each size bucket. A mean over mixed sizes says little about the cost.
+	 */
+	[[nodiscard]] ComplexityFit complexity() const;
+
+	/*!
+	 * @brief Prints the size buckets, the fitted complexity is shown by `print`.
+	 */
+	template <class Period = std::chrono::seconds::period>
+	void printSizes(std::string const& name = "", int precision = 4) const
+	{
+		auto buckets = sizeBuckets();
+		if (buckets.empty()) {
+			return;
+		}
+
+		std::vector<std::pair<int, std::string>> tags;
+		std::vector<std::string>                 colors;
+		std::vector<std::vector<std::wstring>>   columns{
+		      {L" Mean size "}, {L" Mean "},    {L" Std dev "}, {L" Min "},
+		      {L" Max "},       {L" Samples "}, {L" Per item "}};
+
+		auto floating = [precision](double value) {
+			std::wstringstream ss;
+			ss << std::fixed << std::setprecision(precision) << L' ' << value << L' ';
+			return ss.str();
+		};
+
+		for (auto const& b : buckets) {
+			tags.emplace_back(0, std::to_string(b.min_size) + "-" + std::to_string(b.max_size));
+			colors.push_back(color_);
+
+			columns[0].push_back(floating(b.mean_size));
+			columns[1].push_back(floating(b.timer.mean<Period>()));
+			columns[2].push_back(floating(b.timer.std<Period>()));
+			columns[3].push_back(floating(b.timer.min<Period>()));
+			columns[4].push_back(floating(b.timer.max<Period>()));
+			columns[5].push_back(L" " + std::to_wstring(b.timer.numSamples()) + L" ");
+			columns[6].push_back(
+			    floating(0.0 < b.mean_size ? b.timer.mean<Period>() / b.mean_size
+			                               : std::numeric_limits<double>::quiet_NaN()));
+		}
+
+		std::vector<std::pair<std::wstring, std::wstring>> component{{L" Size ", L""}};
+		addTags(component, tags);
+
+		printTable(header(name.empty() ? tag_ + " size" : name, unit<Period>()), component,
+		           colors, columns, false);
+	}
+
+	void printSizesSeconds(std::string const& name = "", int precision = 4) const;
+
+	void printSizesMilliseconds(std::string const& name = "", int precision = 4) const;
+
+	void printSizesMicroseconds(std::string const& name = "", int precision = 4) const;
+
+	void printSizesNanoseconds(std::string const& name = "", int precision = 4) const;
+
+	/*!
+	 * @brief Sets the latency budget of this timing. Each sample that takes longer than
+	 * `budget` is counted as a deadline miss and, if set, `callback` is invoked.
+	 *
+	 * @param budget The maximum duration of a sample.
+	 * @param callback Invoked for each deadline miss.
+	 * @param deferred Whether `callback` should be invoked on a background thread instead
+	 * of by the thread calling `stop`. Deferred invocations still pending when the budget
+	 * is set or cleared again, or the timing is destroyed, are dropped.
+	 */
+	void setBudget(std::chrono::high_resolution_clock::duration budget,
+	               BudgetCallback callback = {}, bool deferred = false);
+
+	void clearBudget();
+
+	[[nodiscard]] bool hasBudget() const;
+
+	[[nodiscard]] std::chrono::high_resolution_clock::duration budget() const;
+
+	[[nodiscard]] std::size_t deadlineMisses() const;
+
+	/*!
+	 * @brief Marks a frame boundary, this timing becomes the root of a periodic loop.
+	 *
+	 * Each frame records its period (the time since the previous boundary) and how long
+	 * each child ran within it. Only aggregates and the `slowest` frames are kept, so the
+	 * memory is bounded.
+	 *
+	 * @note The first call only marks the start of the first frame.
+	 *
+	 * @param slowest Number of slowest frames to keep, if fewer than before the fastest of
+	 * those kept are dropped.
+	 */
+	void frame(std::size_t slowest = 10);
+
+	[[nodiscard]] std::size_t numFrames() const;
+
+	/*!
+	 * @brief Statistics of the frame periods, the standard deviation is the jitter.
+	 */
+	[[nodiscard]] Timer framePeriod() const;
+
+	[[nodiscard]] Histogram framePeriodHistogram() const;
+
+	/*!
+	 * @brief The slowest frames, slowest first.
+	 */
+	[[nodiscard]] std::vector<Frame> slowestFrames() const;
+
+	/*!
+	 * @brief Keeps the `num` slowest samples of this timing, with the time they started,
+	 * the thread that took them and the enclosing scopes.
+	 *
+	 * @note A sample only pays for the capture if it is among the slowest so far.
+	 *
+	 * @param num Number of slowest samples to keep, zero disables the capture.
+	 */
+	void captureSlowest(std::size_t num);
+
+	[[nodiscard]] std::size_t numCaptureSlowest() const;
+
+	/*!
+	 * @brief The captured slowest samples, slowest first.
+	 */
+	[[nodiscard]] std::vector<Sample> slowestSamples() const;
+
+	template <class Period = std::chrono::seconds::period>
+	void printSlowestSamples(std::string const& name = "", int precision = 4) const
+	{
+		auto samples = slowestSamples();
+		if (samples.empty()) {
+			return;
+		}
+
+		std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
+
+		std::vector<std::pair<int, std::string>> tags;
+		std::vector<std::string>                 colors;
+		std::vector<std::vector<std::wstring>>   columns{
+		      {L" Duration "}, {L" Start "}, {L" Thread "}, {L" Scope "}};
+		for (std::size_t i{}; samples.size() > i; ++i) {
+			auto const& s = samples[i];
+
+			tags.emplace_back(0, "#" + std::to_string(i + 1));
+			colors.push_back(color_);
+
+			std::wstringstream ss;
+			ss << std::fixed << std::setprecision(precision) << L' '
+			   << std::chrono::duration<double, Period>(s.duration).count() << L' ';
+			columns[0].push_back(ss.str());
+			columns[1].push_back(L" " + timestamp(s.start) + L" ");
+
+			std::wstringstream id;
+			id << L' ' << s.thread << L' ';
+			columns[2].push_back(id.str());
+
+			std::string scope;
+			for (auto const& t : s.path) {
+				scope += (scope.empty() ? "" : "/") + t;
+			}
+			columns[3].push_back(L" " + converter.from_bytes(scope) + L" ");
+		}
+
+		std::vector<std::pair<std::wstring, std::wstring>> component{{L" Slowest ", L""}};
+		addTags(component, tags);
+
+		printTable(header(name.empty() ? tag_ + " slowest" : name, unit<Period>()),
+		           component, colors, columns, false);
+	}
+
+	void printSlowestSamplesSeconds(std::string const& name = "", int precision = 4) const;
+
+	void printSlowestSamplesMilliseconds(std::string const& name = "",
+	                                     int                precision = 4) const;
+
+	void printSlowestSamplesMicroseconds(std::string const& name = "",
+	                                     int                precision = 4) const;
+
+	void printSlowestSamplesNanoseconds(std::string const& name = "",
+	                                    int                precision = 4) const;
+
+	/*!
+	 * @brief Keeps statistics per thread for this timing, to see whether its parallel
+	 * sections suffer from stragglers or serialization.
+	 *
+	 * A parallel section lasts from when a thread starts this timing while no other
+	 * thread runs it, until no thread runs it anymore.
+	 */
+	void trackThreads(bool enable = true);
+
+	[[nodiscard]] bool tracksThreads() const;
+
+	[[nodiscard]] std::map<std::thread::id, Timer> threadTimers() const;
+
+	/*!
+	 * @brief The wall time of the parallel sections.
+	 */
+	[[nodiscard]] Timer wallTimer() const;
+
+	/*!
+	 * @brief The total time of the slowest thread divided by the mean total time of the
+	 * threads, 1 means perfectly balanced.
+	 */
+	[[nodiscard]] double imbalance() const;
+
+	/*!
+	 * @brief The summed time of the threads divided by the wall time times the number of
+	 * threads, for the parallel sections. 1 means no thread was ever waiting.
+	 */
+	[[nodiscard]] double parallelEfficiency() const;
+
+	/*!
+	 * @brief The thread with the largest total time.
+	 */
+	[[nodiscard]] std::thread::id slowestThread() const;
+
+	template <class Period = std::chrono::seconds::period>
+	void printThreads(std::string const& name = "", int precision = 4) const
+	{
+		std::lock_guard lock(mutex_);
+
+		if (!threads_) {
+			return;
+		}
+
+		std::vector<std::pair<std::thread::id, Timer const*>> threads;
+		for (auto const& [id, t] : threads_->timers) {
+			threads.emplace_back(id, &t);
+		}
+		// Slowest first
+		std::sort(std::begin(threads), std::end(threads), [](auto const& a, auto const& b) {
+			return a.second->total_ > b.second->total_;
+		});
+
+		std::vector<std::pair<int, std::string>> tags{{0, "Wall"}};
+		std::vector<std::string>                 colors{color_};
+		std::vector<Timer const*>                timers{&threads_->wall};
+		for (auto const& [id, t] : threads) {
+			std::stringstream ss;
+			ss << id;
+			tags.emplace_back(0, ss.str());
+			colors.push_back(color_);
+			timers.push_back(t);
+		}
+
+		std::vector<std::vector<std::wstring>> columns{
+		    {L" Total "},   {L" Mean "}, {L" Min "},        {L" Max "},
+		    {L" Samples "}, {L" Load "}, {L" Imbalance "}, {L" Efficiency "}};
+
+		auto floating = [precision](double value) {
+			std::wstringstream ss;
+			ss << std::fixed << std::setprecision(precision) << L' ' << value << L' ';
+			return ss.str();
+		};
+
+		double slowest =
+		    threads.empty() ? 0.0 : threads.front().second->template total<Period>();
+		for (auto t : timers) {
+			columns[0].push_back(floating(t->template total<Period>()));
+			columns[1].push_back(floating(t->template mean<Period>()));
+			columns[2].push_back(floating(t->template min<Period>()));
+			columns[3].push_back(floating(t->template max<Period>()));
+			columns[4].push_back(L" " + std::to_wstring(t->numSamples()) + L" ");
+			// Relative to the slowest thread
+			columns[5].push_back(&threads_->wall == t
+			                         ? L" "
+			                         : floating(t->template total<Period>() / slowest));
+			// Of the node, shown on the wall row
+			columns[6].push_back(&threads_->wall == t ? floating(imbalanceImpl()) : L" ");
+			columns[7].push_back(&threads_->wall == t ? floating(parallelEfficiencyImpl())
+			                                          : L" ");
+		}
+
+		std::vector<std::pair<std::wstring, std::wstring>> component{{L" Thread ", L""}};
+		addTags(component, tags);
+
+		printTable(header(name.empty() ? tag_ + " thread" : name, unit<Period>()),
+		           component, colors, columns, false);
+	}
+
+	void printThreadsSeconds(std::string const& name = "", int precision = 4) const;
+
+	void printThreadsMilliseconds(std::string const& name = "", int precision = 4) const;
+
+	void printThreadsMicroseconds(std::string const& name = "", int precision = 4) const;
+
+	void printThreadsNanoseconds(std::string const& name = "", int precision = 4) const;
+
+	/*!
+	 * @brief Records a time series of this timing, the statistics of the samples per
+	 * interval of time at each of `resolutions`, to find periodic stalls.
+	 *
+	 * @note The memory is bounded by the number of intervals. An empty `resolutions`
+	 * stops the recording and discards the series.
+	 */
+	void recordSeries(std::vector<TimeSeries::Resolution> const& resolutions =
+	                      TimeSeries::defaultResolutions());
+
+	[[nodiscard]] bool recordsSeries() const;
+
+	/*!
+	 * @brief The recorded time series, without resolutions if none is recorded.
+	 */
+	[[nodiscard]] TimeSeries series() const;
+
+	/*!
+	 * @brief Writes every start and stop of this timing and its children to `journal`,
+	 * nullptr to stop journaling.
+	 */
+	void setJournal(std::shared_ptr<Journal> journal);
+
+	/*!
+	 * @brief Bounds the size of this timing's tree, for processes that run for a long time
+	 * with dynamic tags (e.g., one per file or request).
+	 *
+	 * A new tag that would exceed a limit is timed in the `otherTag()` child of its parent
+	 * instead, so the statistics are kept. `compact` folds existing nodes into it.
+	 *
+	 * @param max_children Maximum number of children of each node, not counting
+	 * `otherTag()`.
+	 * @param max_nodes Maximum number of nodes in the tree, including this.
+	 * @param max_bytes Maximum memory of the nodes, i.e., of the tree structure, the tags
+	 * and the basic statistics. The optional per-node data (e.g., `captureSlowest`,
+	 * `recordSeries` or samples with sizes) is bounded by its own parameters and not
+	 * counted, use `memoryUsage` for the total.
+	 */
+	void setLimits(std::size_t max_children,
+	               std::size_t max_nodes = std::numeric_limits<std::size_t>::max(),
+	               std::size_t max_bytes = std::numeric_limits<std::size_t>::max());
+
+	void clearLimits();
+
+	static constexpr char const* otherTag() { return "(other)"; }
+
+	/*!
+	 * @brief Number of new tags timed in `otherTag()` because of a limit.
+	 */
+	[[nodiscard]] std::size_t numOverflows() const;
+
+	/*!
+	 * @brief Folds the nodes without children that are not running into the `otherTag()`
+	 * child of their parent, least total time first, until the tree has at most
+	 * `max_nodes` nodes. Their statistics are added to `otherTag()`.
+	 *
+	 * @warning References to the folded nodes are invalidated.
+	 *
+	 * @return The number of nodes folded.
+	 */
+	std::size_t compact(std::size_t max_nodes);
+
+	/*!
+	 * @brief Number of nodes in the tree, including this.
+	 */
+	[[nodiscard]] std::size_t numNodes() const;
+
+	/*!
+	 * @brief Estimated number of bytes used by this timing and its children.
+	 */
+	[[nodiscard]] std::size_t memoryUsage() const;
+
+	template <class Period = std::chrono::seconds::period>
+	void printFrames(std::string const& name = "", int precision = 4) const
+	{
+		std::lock_guard lock(mutex_);
+
+		if (!frames_) {
+			return;
+		}
+
+		auto const& f       = *frames_;
+		auto        slowest = sortedSlowestFrames();
+
+		std::vector<std::pair<int, std::string>> tags{{0, tag_}};
+		std::vector<std::string>                 colors{color_};
+		for (auto const& [tag, _] : f.children) {
+			tags.emplace_back(0, tag);
+			auto it = children_.find(tag);
+			colors.push_back(std::end(children_) == it ? "" : it->second.color_);
+		}
+
+		std::array<double, 3> const p{50, 90, 99};
+
+		std::vector<std::vector<std::wstring>> columns{
+		    {L" Mean "}, {L" Std dev "}, {L" Min "}, {L" Max "},
+		    {L" p50 "},  {L" p90 "},     {L" p99 "}, {L" Slowest "}};
+
+		auto add = [&](Timer const& t, Histogram const& h, std::wstring const& dominant) {
+			std::array<double, 7> v{t.mean<Period>(),         t.std<Period>(),
+			                        t.min<Period>(),          t.max<Period>(),
+			                        h.percentile<Period>(p[0]), h.percentile<Period>(p[1]),
+			                        h.percentile<Period>(p[2])};
+			for (std::size_t i{}; v.size() > i; ++i) {
+				std::wstringstream ss;
+				ss << std::fixed << std::setprecision(precision) << L' ' << v[i] << L' ';
+				columns[i].push_back(ss.str());
+			}
+			columns[7].push_back(dominant);
+		};
+
+		add(f.period, f.histogram, L" " + std::to_wstring(slowest.size()) + L" ");
+		for (auto const& [tag, c] : f.children) {
+			std::size_t dominant{};
+			for (auto const& s : slowest) {
+				dominant += tag == s.dominant();
+			}
+			add(c.timer, c.histogram, L" " + std::to_wstring(dominant) + L" ");
+		}
+
+		std::vector<std::pair<std::wstring, std::wstring>> component{{L" Frame ", L""}};
+		addTags(component, tags);
+
+		printTable(header(name.empty() ? "Frame" : name + " frame", unit<Period>()),
+		           component, colors, columns, false);
+
+		if (slowest.empty()) {
+			return;
+		}
+
+		// Slowest frames, after a row with the mean of all frames for reference
+		std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
+
+		auto floating = [precision](double value) {
+			std::wstringstream ss;
+			ss << std::fixed << std::setprecision(precision) << L' ' << value << L' ';
+			return ss.str();
+		};
+
+		tags    = {{0, "Mean"}};
+		colors  = {""};
+		columns = {{L" Period ", floating(f.period.mean<Period>())}, {L" Dominant ", L" "}};
+		for (auto const& [tag, c] : f.children) {
+			columns.push_back({L" " + converter.from_bytes(tag) + L" ",
+			                   floating(c.timer.template mean<Period>())});
+		}
+
+		for (auto const& s : slowest) {
+			tags.emplace_back(0, "#" + std::to_string(s.index));
+			colors.emplace_back("");
+
+			columns[0].push_back(
+			    floating(std::chrono::duration<double, Period>(s.period).count()));
+			columns[1].push_back(L" " + converter.from_bytes(s.dominant()) + L" ");
+
+			std::size_t i = 2;
+			for (auto const& [tag, _] : f.children) {
+				auto it = std::find_if(std::begin(s.children), std::end(s.children),
+				                       [&tag = tag](auto const& e) { return tag == e.first; });
+				columns[i++].push_back(
+				    std::end(s.children) == it
+				        ? L" nan "
+				        : floating(std::chrono::duration<double, Period>(it->second).count()));
+			}
+		}
+
+		component = {{L" Slowest ", L""}};
+		addTags(component, tags);
+
+		printTable(header(name.empty() ? "Slowest frame" : name + " slowest frame",
+		                  unit<Period>()),
+		           component, colors, columns, false);
+	}
+
+	void printFramesSeconds(std::string const& name = "", int precision = 4) const;
+
+	void printFramesMilliseconds(std::string const& name = "", int precision = 4) const;
+
+	void printFramesMicroseconds(std::string const& name = "", int precision = 4) const;
+
+	void printFramesNanoseconds(std::string const& name = "", int precision = 4) const;
+
 	std::string const& color() const;
 
 	void setColor(std::string const& color);
@@ -183,7 +744,7 @@ class Timing
 	           int group_colors_level = std::numeric_limits<int>::max(),
 	           int precision          = 4) const
 	{
-		print("", random_colors, bold, info, group_colors_level, precision);
+		print<Period>("", random_colors, bold, info, group_colors_level, precision);
 	}
 
 	template <class Period = std::chrono::seconds::period>
@@ -191,36 +752,13 @@ class Timing
 	           bool info = true, int group_colors_level = std::numeric_limits<int>::max(),
 	           int precision = 4) const
 	{
-		using namespace std::string_literals;
-
-		std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
-		static constexpr std::array const RC{redColor(),  greenColor(),   yellowColor(),
-		                                     blueColor(), magentaColor(), cyanColor(),
-		                                     whiteColor()};
-
-		std::wstring header_left =
-		    L" " + (name.empty() ? L"Timings" : converter.from_bytes(name) + L" timings") +
-		    L" in " + unit<Period>() + L" ";
-		std::wstring header_right = L" UFO 🛸 ";
-
-		// Left + right + seperator
-		std::size_t header_length = header_left.length() + header_right.length() + 1;
-
 		auto timers = timings();
 
-		std::vector<std::pair<std::wstring, std::wstring>> component{{L" Component ", L""}};
-		addTags(component, timers);
-
-		std::size_t component_length{};
-		for (auto const& [prefix, tag] : component) {
-			component_length = std::max(component_length, prefix.length() + tag.length());
-		}
-
-		std::array data{
-		    std::vector<std::string>{" Total "s}, std::vector<std::string>{" Last "s},
-		    std::vector<std::string>{" Mean "s},  std::vector<std::string>{" Std dev "s},
-		    std::vector<std::string>{" Min "s},   std::vector<std::string>{" Max "s}};
-		std::array<std::function<double(Timing const&)>, data.size()> fun{
+		std::vector<std::vector<std::wstring>> columns{{L" Total "},   {L" Last "},
+		                                               {L" Mean "},    {L" Std dev "},
+		                                               {L" Min "},     {L" Max "},
+		                                               {L" Samples "}, {L" Threads "}};
+		std::array<std::function<double(Timing const&)>, 6> fun{
 		    [](Timing const& t) { return t.timer_.total<Period>(); },
 		    [](Timing const& t) { return t.timer_.last<Period>(); },
 		    [](Timing const& t) { return t.timer_.mean<Period>(); },
@@ -229,199 +767,18 @@ class Timing
 		    [](Timing const& t) { return t.timer_.max<Period>(); }};
 
 		for (std::size_t i{}; fun.size() > i; ++i) {
-			addFloating<Period>(data[i], timers, precision, fun[i]);
-		}
-
-		std::array<std::size_t, data.size()> data_length;
-		for (std::size_t i{}; data.size() > i; ++i) {
-			data_length[i] = maxLength(data[i]);
-		}
-
-		std::vector<std::wstring> samples{L" Samples "};
-		addNumSamples(samples, timers);
-		std::size_t samples_length = maxLength(samples);
-
-		std::vector<std::wstring> threads{L" Threads "};
-		addNumThreads(threads, timers);
-		std::size_t threads_length = maxLength(threads);
-
-		std::size_t total_length =
-		    std::accumulate(std::begin(data_length), std::end(data_length),
-		                    component_length + 1 + samples_length + threads_length);
-		total_length = std::max(total_length, header_length);
-
-		{
-			// Header
-			std::size_t header_sep_pos = std::max(header_left.length(), total_length / 2);
-
-			auto t_1 = converter.to_bytes(std::wstring(header_sep_pos, L'─'));
-			auto t_2 =
-			    converter.to_bytes(std::wstring(total_length - header_sep_pos - 1, L'─'));
-			std::printf("╭%s┬%s╮\n", t_1.c_str(), t_2.c_str());
-			t_1     = converter.to_bytes(header_left);
-			t_2     = converter.to_bytes(header_right);
-			int s_1 = static_cast<int>(header_sep_pos);
-			int s_2 = total_length - header_sep_pos + 1;
-			std::printf("│%-*s│%*s│\n", s_1, t_1.c_str(), s_2, t_2.c_str());
-			if (component_length == header_sep_pos) {
-				t_1 = converter.to_bytes(std::wstring(header_sep_pos, L'─'));
-				t_2 = converter.to_bytes(std::wstring(total_length - header_sep_pos - 1, L'─'));
-				std::printf("├%s┼%s┤\n", t_1.c_str(), t_2.c_str());
-			} else if (component_length < header_sep_pos) {
-				t_1 = converter.to_bytes(std::wstring(component_length, L'─'));
-				t_2 =
-				    converter.to_bytes(std::wstring(header_sep_pos - component_length - 1, L'─'));
-				auto t_3 =
-				    converter.to_bytes(std::wstring(total_length - header_sep_pos - 1, L'─'));
-				std::printf("├%s┬%s┴%s┤\n", t_1.c_str(), t_2.c_str(), t_3.c_str());
-			} else {
-				t_1 = converter.to_bytes(std::wstring(header_sep_pos, L'─'));
-				t_2 =
-				    converter.to_bytes(std::wstring(component_length - header_sep_pos - 1, L'─'));
-				auto t_3 =
-				    converter.to_bytes(std::wstring(total_length - component_length - 1, L'─'));
-				std::printf("├%s┴%s┬%s┤\n", t_1.c_str(), t_2.c_str(), t_3.c_str());
-			}
-		}
-
-		{
-			// Labels
-			auto [left_pad, right_pad] = centeringPadding(component[0].first, component_length);
-			std::printf("│%*s%s%*s│", left_pad, "",
-			            converter.to_bytes(component[0].first).c_str(), right_pad, "");
-			for (std::size_t i{0}; data.size() != i; ++i) {
-				auto [left_pad, right_pad] = centeringPadding(data[i][0], data_length[i]);
-				std::printf("%*s%s%*s", left_pad, "", data[i][0].c_str(), right_pad, "");
-			}
-			std::tie(left_pad, right_pad) = centeringPadding(samples[0], samples_length);
-			std::printf("%*s%s%*s", left_pad, "", converter.to_bytes(samples[0]).c_str(),
-			            right_pad, "");
-			std::tie(left_pad, right_pad) = centeringPadding(threads[0], threads_length);
-			std::printf("%*s%s%*s", left_pad, "", converter.to_bytes(threads[0]).c_str(),
-			            right_pad, "");
-			std::printf("│\n");
-			auto t_1 = converter.to_bytes(std::wstring(component_length, L'─'));
-			auto t_2 =
-			    converter.to_bytes(std::wstring(total_length - component_length - 1, L'─'));
-			std::printf("├%s┼%s┤\n", t_1.c_str(), t_2.c_str());
+			addFloating<Period>(columns[i], timers, precision, fun[i]);
 		}
+		addNumSamples(columns[6], timers);
+		addNumThreads(columns[7], timers);
 
-		{
-			// Data
-			int rng_color = 0;
-			for (std::size_t i{1}; component.size() > i; ++i) {
-				rng_color += timers[i - 1].level <= group_colors_level;
-				std::string color = bold ? "\033[1m" : "";
-				color += random_colors ? RC[rng_color % RC.size()]
-				                       : timers[i - 1].timing->color().c_str();
-
-				std::printf("│");
-				{
-					// Component
-					if (1 == i) {
-						auto [left_pad, right_pad] =
-						    centeringPadding(component[i].second, component_length);
-						std::printf("%*s%s%s%*s", left_pad, "", color.c_str(),
-						            converter.to_bytes(component[i].second).c_str(), right_pad, "");
-					} else {
-						auto prefix = converter.to_bytes(component[i].first);
-						auto tag    = converter.to_bytes(component[i].second);
-						int  s      = component_length - component[i].first.length() -
-						        component[i].second.length();
-						std::printf("%s%s%s%*s", prefix.c_str(), color.c_str(), tag.c_str(), s, "");
-					}
-					std::printf("%s│%s", resetColor(), color.c_str());
-				}
-
-				{
-					// Other data
-					for (std::size_t j{0}; data.size() > j; ++j) {
-						auto [left_pad, right_pad] = centeringPadding(data[j][i], data_length[j]);
-						if (" nan " == data[j][i]) {
-							// Center aligned
-							std::printf("%*s%s%*s", left_pad, "", data[j][i].c_str(), right_pad, "");
-						} else {
-							// Left aligned
-							std::printf("%s%*s", data[j][i].c_str(), left_pad + right_pad, "");
-						}
-					}
-					int s = static_cast<int>(samples_length - samples[i].length());
-					std::printf("%s%*s", converter.to_bytes(samples[i]).c_str(), s, "");
-					int t = static_cast<int>(threads_length - threads[i].length());
-					std::printf("%s%*s", converter.to_bytes(threads[i]).c_str(), t, "");
-				}
-
-				// Reset color
-				std::printf("%s│\n", resetColor());
-
-				{
-					// First seperator
-					if (1 == i && component.size() > 2) {
-						auto t_1 = converter.to_bytes(std::wstring(component_length, L'╌'));
-						auto t_2 = converter.to_bytes(
-						    std::wstring(total_length - component_length - 1, L'╌'));
-						std::printf("├%s┼%s┤\n", t_1.c_str(), t_2.c_str());
-					}
-				}
-			}
-		}
+		addBudget<Period>(columns, timers, precision);
+		addThreads<Period>(columns, timers, precision);
+		addWork<Period>(columns, timers, precision);
+		addComplexity(columns, timers, precision);
 
-		bool running    = false;
-		bool paused     = false;
-		bool concurrent = false;
-		if (info) {
-			// Info
-			for (auto const& s : samples) {
-				running = running || (2 <= s.length() && L'¹' == s[s.length() - 2]) ||
-				          (3 <= s.length() && L'¹' == s[s.length() - 3]);
-				paused = paused || (2 <= s.length() && L'²' == s[s.length() - 2]);
-				if (running && paused) {
-					break;
-				}
-			}
-
-			for (auto const& [_, tag] : component) {
-				if (2 <= tag.length() && L'³' == tag[tag.length() - 2]) {
-					concurrent = true;
-					break;
-				}
-			}
-
-			if (running || concurrent) {
-				auto t_1 = converter.to_bytes(std::wstring(component_length, L'─'));
-				auto t_2 =
-				    converter.to_bytes(std::wstring(total_length - component_length - 1, L'─'));
-				std::printf("├%s┴%s┤\n", t_1.c_str(), t_2.c_str());
-				if (running) {
-					std::wstring info = L" ¹ # running threads that are not accounted for ";
-					int          s    = static_cast<int>(total_length - info.length());
-					std::printf("│%s%*s│\n", converter.to_bytes(info).c_str(), s, "");
-				}
-				if (paused) {
-					std::wstring info = L" ² Indicates that the timer is paused ";
-					int          s    = static_cast<int>(total_length - info.length());
-					std::printf("│%s%*s│\n", converter.to_bytes(info).c_str(), s, "");
-				}
-				if (concurrent) {
-					std::wstring info = L" ³ Indicates that the timer has run concurrently ";
-					int          s    = static_cast<int>(total_length - info.length());
-					std::printf("│%s%*s│\n", converter.to_bytes(info).c_str(), s, "");
-				}
-			}
-		}
-
-		{
-			// Footer
-			if (running || concurrent) {
-				auto t = converter.to_bytes(std::wstring(total_length, L'─'));
-				std::printf("╰%s╯\n", t.c_str());
-			} else {
-				auto t_1 = converter.to_bytes(std::wstring(component_length, L'─'));
-				auto t_2 =
-				    converter.to_bytes(std::wstring(total_length - component_length - 1, L'─'));
-				std::printf("╰%s┴%s╯\n", t_1.c_str(), t_2.c_str());
-			}
-		}
+		printTable(header(name, unit<Period>()), tags(timers),
+		           colors(timers, random_colors, bold, group_colors_level), columns, info);
 	}
 
 	void printSeconds(bool random_colors = false, bool bold = false, bool info = true,
@@ -460,6 +817,31 @@ class Timing
 	                      int group_colors_level = std::numeric_limits<int>::max(),
 	                      int precision          = 4) const;
 
+	/*!
+	 * @brief Writes the timings in the OpenMetrics text exposition format.
+	 *
+	 * @note Each node is identified by the `path` label, which is the tags from the root
+	 * to the node joined by '/'. All values are in seconds.
+	 *
+	 * @param out The stream to write to.
+	 * @param prefix Prefix of the metric family names.
+	 */
+	void writeOpenMetrics(std::ostream& out, std::string const& prefix = "ufotime") const;
+
+	[[nodiscard]] std::string openMetrics(std::string const& prefix = "ufotime") const;
+
+	/*!
+	 * @brief Replaces the timings with those in `in`, as written by `writeOpenMetrics`.
+	 *
+	 * @note Only the statistics are restored, tags containing '/' are split into several
+	 * nodes.
+	 *
+	 * @param in The stream to read from.
+	 * @param prefix Prefix of the metric family names.
+	 * @return Whether any timings were read.
+	 */
+	bool readOpenMetrics(std::istream& in, std::string const& prefix = "ufotime");
+
  private:
 	Timing(Timing* parent, std::string const& tag);
 
@@ -496,14 +878,85 @@ class Timing
 
 	Timing* findDeepest(std::thread::id id);
 
+	// Shared by the nodes of a tree with limits
+	struct Limits {
+		std::size_t              max_children;
+		std::size_t              max_nodes;
+		std::size_t              max_bytes;
+		std::atomic<std::size_t> nodes{0};
+		std::atomic<std::size_t> bytes{0};
+		std::atomic<std::size_t> overflows{0};
+	};
+
+	/*!
+	 * @brief The child with `tag`, which is created if it does not exist and no limit is
+	 * reached, otherwise the `otherTag()` child.
+	 *
+	 * @note The caller holds the lock of this.
+	 */
+	Timing& child(std::string const& tag);
+
+	/*!
+	 * @brief Reserves a node and `bytes` in the limits, false if either limit would be
+	 * exceeded.
+	 *
+	 * @note The caller holds the lock of this, which has limits.
+	 */
+	bool reserve(std::size_t bytes);
+
+	// The `childBytes` of the nodes below this
+	[[nodiscard]] std::size_t treeBytes() const;
+
+	// Estimated bytes of a new child with `tag`, its tree node, tags and statistics
+	static std::size_t childBytes(std::string const& tag);
+
+	// Folds `leaf` into `otherTag()` if it still has no children and is not running,
+	// `nodes` is decreased unless `otherTag()` had to be added
+	bool fold(Timing& leaf, std::size_t& nodes);
+
+	void foldableRecurs(std::vector<std::pair<double, Timing*>>& leaves);
+
+	// Removes the nodes below this, giving back their limits and journal ids, `mutex_`
+	// must be held
+	void clearChildren();
+
+	void setLimitsRecurs(std::shared_ptr<Limits> const& limits);
+
+	// The tags from the root to this
+	std::vector<std::string> path() const;
+
 	std::size_t stop(std::chrono::time_point<std::chrono::high_resolution_clock> time,
 	                 std::size_t                                                 levels);
 
+	bool stopImpl(std::initializer_list<std::pair<std::string const, double>> work,
+	              std::size_t const*                                          size);
+
+	// Index of the size bucket of `size`, the number of bits needed to represent it
+	static std::size_t sizeIndex(std::size_t size);
+
+	// The caller holds the lock of this
+	void addSizeSample(std::size_t                                                 size,
+	                   std::chrono::time_point<std::chrono::high_resolution_clock> start,
+	                   std::chrono::time_point<std::chrono::high_resolution_clock> stop);
+
+	// The caller holds the lock of this
+	[[nodiscard]] std::vector<SizeBucket> sizeBucketsImpl() const;
+
 	std::pair<std::size_t, std::chrono::high_resolution_clock::duration> stopRecurs(
 	    std::thread::id                                             id,
 	    std::chrono::time_point<std::chrono::high_resolution_clock> time,
 	    std::size_t                                                 levels);
 
+	struct NodeStats {
+		std::string path;
+		Timer       timer;
+		std::size_t running_threads;
+		std::size_t max_concurrent_threads;
+		std::size_t deadline_misses;
+	};
+
+	void nodeStatsRecurs(std::vector<NodeStats>& data, std::string const& path) const;
+
 	struct TimingNL {
 		Timing const* timing;
 		std::size_t   num;
@@ -529,35 +982,178 @@ class Timing
 
 	int maxTagLength(std::vector<TimingNL> const& timers) const;
 
-	void addTags(std::vector<std::pair<std::wstring, std::wstring>>& data,
-	             std::vector<TimingNL> const&                        timers) const;
+	/*!
+	 * @brief Adds the tags, prefixed by the tree structure, to `data`.
+	 *
+	 * @param tags The level and tag of each row, in depth-first order.
+	 */
+	static void addTags(std::vector<std::pair<std::wstring, std::wstring>>& data,
+	                    std::vector<std::pair<int, std::string>> const&     tags);
+
+	std::vector<std::pair<std::wstring, std::wstring>> tags(
+	    std::vector<TimingNL> const& timers) const;
+
+	std::vector<std::string> colors(std::vector<TimingNL> const& timers,
+	                                bool random_colors, bool bold,
+	                                int group_colors_level) const;
+
+	static std::wstring header(std::string const& name, std::wstring const& unit);
+
+	/*!
+	 * @brief Prints a table in the same style as `print`.
+	 *
+	 * @param header_left The text in the left part of the header.
+	 * @param component The component column, the first element is the label.
+	 * @param colors The color of each row, excluding the label row.
+	 * @param columns The data columns, the first element of each column is the label.
+	 * @param info Whether to print the info about the superscripts (if any).
+	 */
+	static void printTable(
+	    std::wstring const&                                       header_left,
+	    std::vector<std::pair<std::wstring, std::wstring>> const& component,
+	    std::vector<std::string> const&                           colors,
+	    std::vector<std::vector<std::wstring>> const&             columns,
+	    bool                                                      info);
+
+	/*!
+	 * @brief As `printTable`, but writes to `out` instead of the standard output.
+	 */
+	static void printTable(
+	    std::ostream& out, std::wstring const& header_left,
+	    std::vector<std::pair<std::wstring, std::wstring>> const& component,
+	    std::vector<std::string> const&                           colors,
+	    std::vector<std::vector<std::wstring>> const& columns, bool info);
 
 	template <class Period, class Fun>
-	void addFloating(std::vector<std::string>& data, std::vector<TimingNL> const& timers,
+	void addFloating(std::vector<std::wstring>& data, std::vector<TimingNL> const& timers,
 	                 int precision, Fun f) const
 	{
-		std::stringstream ss;
+		std::wstringstream ss;
 		for (auto const& t : timers) {
 			ss << std::fixed << std::setprecision(precision);
-			ss << ' ' << f(*t.timing) << ' ';
+			ss << L' ' << f(*t.timing) << L' ';
 			data.push_back(ss.str());
 			ss = {};
 		}
 	}
 
+	template <class Period>
+	void addWork(std::vector<std::vector<std::wstring>>& columns,
+	             std::vector<TimingNL> const& timers, int precision) const
+	{
+		std::set<std::string> names;
+		for (auto const& t : timers) {
+			for (auto const& [name, _] : t.timing->work_) {
+				names.insert(name);
+			}
+		}
+
+		std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
+		for (auto const& name : names) {
+			std::wstring n = converter.from_bytes(name);
+
+			std::vector<std::wstring> rate{L" " + n + L"/s "};
+			std::vector<std::wstring> per{L" " + shortUnit<Period>() + L"/" + n + L" "};
+			for (auto const& t : timers) {
+				auto it = t.timing->work_.find(name);
+				if (std::end(t.timing->work_) == it) {
+					rate.push_back(L" nan ");
+					per.push_back(L" nan ");
+				} else {
+					// Samples without the counter did not do that work
+					auto time = t.timing->work_time_.at(name);
+					rate.push_back(siPrefixed(
+					    it->second / std::chrono::duration<double>(time).count(), precision));
+					std::wstringstream ss;
+					ss << std::fixed << std::setprecision(precision);
+					ss << L' ' << std::chrono::duration<double, Period>(time).count() / it->second
+					   << L' ';
+					per.push_back(ss.str());
+				}
+			}
+			columns.push_back(std::move(rate));
+			columns.push_back(std::move(per));
+		}
+	}
+
+	template <class Period>
+	void addBudget(std::vector<std::vector<std::wstring>>& columns,
+	               std::vector<TimingNL> const& timers, int precision) const
+	{
+		bool any = false;
+		for (auto const& t : timers) {
+			any = any || t.timing->hasBudget();
+		}
+
+		if (!any) {
+			return;
+		}
+
+		std::vector<std::wstring> budget{L" Budget "};
+		addFloating<Period>(budget, timers, precision, [](Timing const& t) {
+			return t.hasBudget()
+			           ? std::chrono::duration<double, Period>(t.budget_).count()
+			           : std::numeric_limits<double>::quiet_NaN();
+		});
+
+		std::vector<std::wstring> misses{L" Misses "};
+		for (auto const& t : timers) {
+			misses.push_back(t.timing->hasBudget()
+			                     ? L" " + std::to_wstring(t.timing->deadline_misses_) + L" "
+			                     : L" nan ");
+		}
+
+		columns.push_back(std::move(budget));
+		columns.push_back(std::move(misses));
+	}
+
+	template <class Period>
+	void addThreads(std::vector<std::vector<std::wstring>>& columns,
+	                std::vector<TimingNL> const& timers, int precision) const
+	{
+		bool any = false;
+		for (auto const& t : timers) {
+			any = any || t.timing->threads_;
+		}
+
+		if (!any) {
+			return;
+		}
+
+		std::vector<std::wstring> imbalance{L" Imbalance "};
+		addFloating<Period>(imbalance, timers, precision,
+		                    [](Timing const& t) { return t.imbalanceImpl(); });
+
+		std::vector<std::wstring> efficiency{L" Efficiency "};
+		addFloating<Period>(efficiency, timers, precision,
+		                    [](Timing const& t) { return t.parallelEfficiencyImpl(); });
+
+		columns.push_back(std::move(imbalance));
+		columns.push_back(std::move(efficiency));
+	}
+
+	void addComplexity(std::vector<std::vector<std::wstring>>& columns,
+	                   std::vector<TimingNL> const& timers, int precision) const;
+
+	static std::wstring siPrefixed(double value, int precision);
+
+	std::vector<Frame> sortedSlowestFrames() const;
+
+	static std::wstring timestamp(std::chrono::system_clock::time_point time);
+
 	void addNumSamples(std::vector<std::wstring>&   data,
 	                   std::vector<TimingNL> const& timers) const;
 
 	void addNumThreads(std::vector<std::wstring>&   data,
 	                   std::vector<TimingNL> const& timers) const;
 
-	std::size_t maxLength(std::vector<std::string> const& data) const;
+	static std::size_t maxLength(std::vector<std::string> const& data);
 
-	std::size_t maxLength(std::vector<std::wstring> const& data) const;
+	static std::size_t maxLength(std::vector<std::wstring> const& data);
 
-	std::pair<int, int> centeringPadding(std::string const& str, int max_width) const;
+	static std::pair<int, int> centeringPadding(std::string const& str, int max_width);
 
-	std::pair<int, int> centeringPadding(std::wstring const& str, int max_width) const;
+	static std::pair<int, int> centeringPadding(std::wstring const& str, int max_width);
 
 	template <class Period>
 	static std::wstring unit()
@@ -579,6 +1175,30 @@ class Timing
 		}
 	}
 
+	template <class Period>
+	static std::wstring shortUnit()
+	{
+		if constexpr (std::is_same_v<Period, std::chrono::nanoseconds::period>) {
+			return L"ns";
+		} else if constexpr (std::is_same_v<Period, std::chrono::microseconds::period>) {
+			return L"µs";
+		} else if constexpr (std::is_same_v<Period, std::chrono::milliseconds::period>) {
+			return L"ms";
+		} else if constexpr (std::is_same_v<Period, std::chrono::seconds::period>) {
+			return L"s";
+		} else if constexpr (std::is_same_v<Period, std::chrono::minutes::period>) {
+			return L"min";
+		} else if constexpr (std::is_same_v<Period, std::chrono::hours::period>) {
+			return L"h";
+		} else {
+			return L"?";
+		}
+	}
+
+	[[nodiscard]] double imbalanceImpl() const;
+
+	[[nodiscard]] double parallelEfficiencyImpl() const;
+
 	[[nodiscard]] int numSamples() const;
 
 	void updateMaxConcurrent();
@@ -605,6 +1225,94 @@ class Timing
 	std::map<std::string, Timing> children_;
 
 	std::size_t max_concurrent_threads_ = 0;
+
+	std::map<std::string, double> work_;
+	// Time of the samples that added to each of `work_`
+	std::map<std::string, std::chrono::high_resolution_clock::duration> work_time_;
+
+	struct SizeStats {
+		Timer  timer;
+		double size_sum = 0.0;
+	};
+
+	// Indexed by `sizeIndex`, empty unless a sample has been recorded with a size
+	std::vector<SizeStats> sizes_;
+
+	std::chrono::high_resolution_clock::duration budget_ =
+	    std::chrono::high_resolution_clock::duration::max();
+	std::shared_ptr<BudgetCallback const> budget_callback_;
+	bool                                  budget_deferred_ = false;
+	std::size_t                           deadline_misses_ = 0;
+
+	struct FrameChild {
+		Timer                                        timer;
+		Histogram                                    histogram;
+		std::chrono::high_resolution_clock::duration last_total =
+		    std::chrono::high_resolution_clock::duration::zero();
+	};
+
+	struct Frames {
+		std::size_t                                                 num_slowest;
+		std::size_t                                                 num = 0;
+		std::chrono::time_point<std::chrono::high_resolution_clock> last{};
+		Timer                                                       period;
+		Histogram                                                   histogram;
+		std::map<std::string, FrameChild>                           children;
+		// Min-heap on the period
+		std::vector<Frame> slowest;
+	};
+
+	std::unique_ptr<Frames> frames_;
+
+	struct SlowestSamples {
+		std::size_t num;
+		// Min-heap on the duration
+		std::vector<Sample> samples;
+	};
+
+	std::unique_ptr<SlowestSamples> slowest_;
+
+	struct Threads {
+		std::map<std::thread::id, Timer> timers;
+		// Wall time of the parallel sections
+		Timer wall;
+		// Sum of the thread time and of the wall time times the number of threads, for the
+		// finished parallel sections
+		std::chrono::high_resolution_clock::duration busy =
+		    std::chrono::high_resolution_clock::duration::zero();
+		std::chrono::high_resolution_clock::duration capacity =
+		    std::chrono::high_resolution_clock::duration::zero();
+		// The current parallel section
+		std::size_t                                                 running = 0;
+		std::chrono::time_point<std::chrono::high_resolution_clock> section_start =
+		    std::chrono::time_point<std::chrono::high_resolution_clock>::max();
+		std::chrono::high_resolution_clock::duration section_busy =
+		    std::chrono::high_resolution_clock::duration::zero();
+		std::set<std::thread::id> section_threads;
+	};
+
+	std::unique_ptr<Threads> threads_;
+
+	std::unique_ptr<TimeSeries> series_;
+
+	std::shared_ptr<Journal> journal_;
+
+	std::shared_ptr<Limits> limits_;
+
+	// The deepest running timing of the calling thread, read by the `Profiler` signal
+	// handler
+	static thread_local Timing* scope_;
+
+	friend class Benchmark;
+	friend class Dashboard;
+	friend class FlatProfile;
+	friend class Journal;
+	friend class Profiler;
+	friend class RealTimeTiming;
+	friend class SharedMemoryPublisher;
+	friend class SharedMemoryReader;
+	friend class TimingDiff;
+	friend class TimingSnapshot;
 };
 }  // namespace ufo
 
@@ -0,0 +1,181 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_TIMING_DIFF_HPP
+#define UFO_TIME_TIMING_DIFF_HPP
+
+// UFO
+#include <ufo/time/statistics.hpp>
+#include <ufo/time/timer.hpp>
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief Compares two `Timing` trees, a baseline and a candidate, node by node.
+ *
+ * Nodes are aligned by their tag path below the root. A node is a regression (or an
+ * improvement) if Welch's t-test rejects equal means at `alpha` and the relative change
+ * of the mean is at least `min_effect`.
+ */
+class TimingDiff
+{
+ public:
+	enum class Change { NONE, IMPROVEMENT, REGRESSION, ADDED, REMOVED };
+
+	struct Node {
+		std::string path;
+		int         level;
+		Timer       baseline;
+		Timer       candidate;
+		WelchTTest  test;
+		Change      change;
+
+		// Difference of the means, in seconds
+		[[nodiscard]] double delta() const;
+
+		// Difference of the means relative to the baseline mean
+		[[nodiscard]] double relative() const;
+	};
+
+	TimingDiff(Timing const& baseline, Timing const& candidate, double alpha = 0.05,
+	           double min_effect = 0.05);
+
+	[[nodiscard]] std::vector<Node> const& nodes() const;
+
+	[[nodiscard]] std::vector<Node> regressions() const;
+
+	[[nodiscard]] std::vector<Node> improvements() const;
+
+	/*!
+	 * @brief The root and the nodes that changed or have a descendant that changed, in
+	 * the order of `nodes`, so they still form a tree.
+	 */
+	[[nodiscard]] std::vector<Node> changedTree() const;
+
+	[[nodiscard]] double alpha() const;
+
+	[[nodiscard]] double minEffect() const;
+
+	template <class Period = std::chrono::seconds::period>
+	void print(bool changed_only = false, int precision = 4) const
+	{
+		std::vector<std::pair<int, std::string>> tags;
+		std::vector<std::string>                 colors;
+		std::vector<std::vector<std::wstring>>   columns{
+		      {L" Baseline "}, {L" Candidate "}, {L" Delta "}, {L" Change "},
+		      {L" p-value "},  {L" Samples "},   {L" "}};
+
+		auto floating = [precision](double value, bool sign = false,
+		                            wchar_t const* suffix = L"") -> std::wstring {
+			if (std::isnan(value)) {
+				return L" nan ";
+			}
+			std::wstringstream ss;
+			ss << std::fixed << std::setprecision(precision) << L' ';
+			if (sign && 0 < value) {
+				ss << L'+';
+			}
+			ss << value << suffix << L' ';
+			return ss.str();
+		};
+
+		constexpr long double s =
+		    static_cast<long double>(Period::den) / static_cast<long double>(Period::num);
+
+		for (auto const& n : changed_only ? changedTree() : nodes_) {
+			tags.emplace_back(n.level, n.path.substr(n.path.rfind('/') + 1));
+			colors.push_back(color(n.change));
+
+			columns[0].push_back(floating(n.baseline.mean<Period>()));
+			columns[1].push_back(floating(n.candidate.mean<Period>()));
+			columns[2].push_back(floating(static_cast<double>(s * n.delta()), true));
+			columns[3].push_back(floating(100.0 * n.relative(), true, L"%"));
+			columns[4].push_back(floating(n.test.p));
+			columns[5].push_back(L" " + std::to_wstring(n.baseline.numSamples()) + L"/" +
+			                     std::to_wstring(n.candidate.numSamples()) + L" ");
+			columns[6].push_back(L" " + symbol(n.change) + L" ");
+		}
+
+		std::vector<std::pair<std::wstring, std::wstring>> component{{L" Component ", L""}};
+		Timing::addTags(component, tags);
+
+		Timing::printTable(Timing::header("Diff", Timing::unit<Period>()), component, colors,
+		                   columns, false);
+	}
+
+	void printSeconds(bool changed_only = false, int precision = 4) const;
+
+	void printMilliseconds(bool changed_only = false, int precision = 4) const;
+
+	void printMicroseconds(bool changed_only = false, int precision = 4) const;
+
+	void printNanoseconds(bool changed_only = false, int precision = 4) const;
+
+	/*!
+	 * @brief Writes the comparison as JSON, with all times in seconds.
+	 */
+	void writeJson(std::ostream& out, bool changed_only = false) const;
+
+ private:
+	static std::string color(Change change);
+
+	static std::wstring symbol(Change change);
+
+	static char const* name(Change change);
+
+ private:
+	std::vector<Node> nodes_;
+	double            alpha_;
+	double            min_effect_;
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_TIMING_DIFF_HPP
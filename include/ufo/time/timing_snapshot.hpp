@@ -0,0 +1,194 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_TIME_TIMING_SNAPSHOT_HPP
+#define UFO_TIME_TIMING_SNAPSHOT_HPP
+
+// UFO
+#include <ufo/time/timer.hpp>
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief A copy of the statistics of a `Timing` tree at one point in time.
+ *
+ * Subtracting an earlier snapshot of the same tree gives the exact statistics of the
+ * samples added in between, so a live tree can be reported per interval without being
+ * reset:
+ *
+ * @code
+ * ufo::TimingSnapshot previous(timing);
+ * // ...
+ * ufo::TimingSnapshot current(timing);
+ * (current - previous).printMilliseconds("Last 10 s");
+ * previous = current;
+ * @endcode
+ */
+class TimingSnapshot
+{
+ public:
+	TimingSnapshot() = default;
+
+	/*!
+	 * @brief Copies `timing` and its descendants.
+	 *
+	 * @note A node is locked only while its statistics and the addresses of its children
+	 * are copied, and unlocked before the children are, so timings started and stopped
+	 * meanwhile are not held up by the rest of the tree. The nodes are therefore copied
+	 * at slightly different times, and `Timing::compact` must not run concurrently, as
+	 * it removes nodes.
+	 */
+	explicit TimingSnapshot(Timing const& timing);
+
+	[[nodiscard]] std::string const& tag() const;
+
+	[[nodiscard]] std::string const& color() const;
+
+	[[nodiscard]] Timer const& timer() const;
+
+	[[nodiscard]] std::map<std::string, TimingSnapshot> const& children() const;
+
+	/*!
+	 * @brief The child with `tag`, or an empty snapshot if there is none.
+	 */
+	[[nodiscard]] TimingSnapshot const& operator[](std::string const& tag) const;
+
+	/*!
+	 * @brief When the snapshot was taken.
+	 */
+	[[nodiscard]] std::chrono::time_point<std::chrono::high_resolution_clock> time() const;
+
+	/*!
+	 * @brief The start of the interval the snapshot covers, the default time point if it
+	 * covers everything since the tree was created.
+	 */
+	[[nodiscard]] std::chrono::time_point<std::chrono::high_resolution_clock> start()
+	    const;
+
+	/*!
+	 * @brief Removes the samples of the earlier snapshot `rhs` of the same tree, see
+	 * `Timer::operator-=`. Nodes missing from `rhs` are kept as they are.
+	 */
+	TimingSnapshot& operator-=(TimingSnapshot const& rhs);
+
+	friend TimingSnapshot operator-(TimingSnapshot lhs, TimingSnapshot const& rhs);
+
+	template <class Period = std::chrono::seconds::period>
+	void print(std::string const& name = "", int precision = 4) const
+	{
+		std::vector<std::pair<int, TimingSnapshot const*>> rows;
+		rowsRecurs(rows, 0);
+
+		std::vector<std::pair<int, std::string>> tags;
+		std::vector<std::string>                 colors;
+		std::vector<std::vector<std::wstring>>   columns{
+		      {L" Total "}, {L" Mean "},    {L" Std dev "}, {L" Min "},
+		      {L" Max "},   {L" Samples "}, {L" Samples/s "}};
+
+		auto fixed = [precision](double value) {
+			std::wstringstream ss;
+			ss << std::fixed << std::setprecision(precision) << L' ' << value << L' ';
+			return ss.str();
+		};
+
+		// Rates are only meaningful for an interval
+		double seconds = decltype(start_){} == start_
+		                     ? std::numeric_limits<double>::quiet_NaN()
+		                     : std::chrono::duration<double>(time_ - start_).count();
+
+		for (auto const& [level, s] : rows) {
+			tags.emplace_back(level, s->tag_);
+			colors.push_back(s->color_);
+
+			Timer const& t = s->timer_;
+			columns[0].push_back(fixed(t.total<Period>()));
+			columns[1].push_back(fixed(t.mean<Period>()));
+			columns[2].push_back(fixed(t.std<Period>()));
+			columns[3].push_back(fixed(t.min<Period>()));
+			columns[4].push_back(fixed(t.max<Period>()));
+			columns[5].push_back(L" " + std::to_wstring(t.numSamples()) + L" ");
+			columns[6].push_back(fixed(t.numSamples() / seconds));
+		}
+
+		std::vector<std::pair<std::wstring, std::wstring>> component{{L" Component ", L""}};
+		Timing::addTags(component, tags);
+
+		Timing::printTable(Timing::header(name, Timing::unit<Period>()), component, colors,
+		                   columns, false);
+	}
+
+	void printSeconds(std::string const& name = "", int precision = 4) const;
+
+	void printMilliseconds(std::string const& name = "", int precision = 4) const;
+
+	void printMicroseconds(std::string const& name = "", int precision = 4) const;
+
+	void printNanoseconds(std::string const& name = "", int precision = 4) const;
+
+ private:
+	TimingSnapshot(Timing const&                                               timing,
+	               std::chrono::time_point<std::chrono::high_resolution_clock> time);
+
+	void rowsRecurs(std::vector<std::pair<int, TimingSnapshot const*>>& rows,
+	                int                                                 level) const;
+
+ private:
+	std::string                                                 tag_;
+	std::string                                                 color_;
+	Timer                                                       timer_;
+	std::map<std::string, TimingSnapshot>                       children_;
+	std::chrono::time_point<std::chrono::high_resolution_clock> time_  = {};
+	std::chrono::time_point<std::chrono::high_resolution_clock> start_ = {};
+};
+}  // namespace ufo
+
+#endif  // UFO_TIME_TIMING_SNAPSHOT_HPP
@@ -0,0 +1,337 @@
+// UFO
+#include <ufo/time/benchmark.hpp>
+#include <ufo/time/statistics.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <limits>
+#include <thread>
+
+// POSIX
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+namespace ufo
+{
+namespace
+{
+std::chrono::nanoseconds threadCpuTime()
+{
+	timespec ts{};
+	::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+double median(std::vector<double> values)
+{
+	if (values.empty()) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	auto mid = std::begin(values) + values.size() / 2;
+	std::nth_element(std::begin(values), mid, std::end(values));
+	if (1 == values.size() % 2) {
+		return *mid;
+	}
+	return 0.5 * (*mid + *std::max_element(std::begin(values), mid));
+}
+
+// Pins the calling thread to a CPU for its lifetime
+class Pin
+{
+ public:
+	explicit Pin(int cpu)
+	{
+#ifdef __linux__
+		if (0 > cpu) {
+			return;
+		}
+
+		pinned_ = 0 == ::pthread_getaffinity_np(::pthread_self(), sizeof(old_), &old_);
+
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		pinned_ =
+		    pinned_ && 0 == ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+#else
+		static_cast<void>(cpu);
+#endif
+	}
+
+	~Pin()
+	{
+#ifdef __linux__
+		if (pinned_) {
+			::pthread_setaffinity_np(::pthread_self(), sizeof(old_), &old_);
+		}
+#endif
+	}
+
+ private:
+#ifdef __linux__
+	cpu_set_t old_;
+	bool      pinned_ = false;
+#endif
+};
+}  // namespace
+
+//
+// Public functions
+//
+
+std::size_t BenchmarkResult::numOutliers() const
+{
+	return static_cast<std::size_t>(
+	    std::count_if(std::begin(repetitions), std::end(repetitions),
+	                  [](auto const& r) { return r.outlier; }));
+}
+
+double BenchmarkResult::relativeError() const
+{
+	if (!(0.0 < mean)) {
+		return std::numeric_limits<double>::infinity();
+	}
+	return 0.5 * (ci_high - ci_low) / mean;
+}
+
+Benchmark::Benchmark(BenchmarkOptions const& options) : options_(options) {}
+
+BenchmarkOptions const& Benchmark::options() const { return options_; }
+
+std::vector<BenchmarkResult> const& Benchmark::results() const { return results_; }
+
+void Benchmark::clear() { results_.clear(); }
+
+void Benchmark::printSeconds(std::string const& name, int precision) const
+{
+	print<std::chrono::seconds::period>(name, precision);
+}
+
+void Benchmark::printMilliseconds(std::string const& name, int precision) const
+{
+	print<std::chrono::milliseconds::period>(name, precision);
+}
+
+void Benchmark::printMicroseconds(std::string const& name, int precision) const
+{
+	print<std::chrono::microseconds::period>(name, precision);
+}
+
+void Benchmark::printNanoseconds(std::string const& name, int precision) const
+{
+	print<std::chrono::nanoseconds::period>(name, precision);
+}
+
+void Benchmark::writeJson(std::ostream& out) const
+{
+	auto number = [&out](double value) -> std::ostream& {
+		return std::isfinite(value) ? out << value : out << "null";
+	};
+
+	auto string = [&out](std::string const& str) -> std::ostream& {
+		out << '"';
+		for (char c : str) {
+			switch (c) {
+				case '"': out << "\\\""; break;
+				case '\\': out << "\\\\"; break;
+				case '\n': out << "\\n"; break;
+				case '\t': out << "\\t"; break;
+				default:
+					if (0x20 > static_cast<unsigned char>(c)) {
+						out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+						    << static_cast<int>(c) << std::dec << std::setfill(' ');
+					} else {
+						out << c;
+					}
+			}
+		}
+		return out << '"';
+	};
+
+	auto flags = out.flags();
+	auto prec  = out.precision(std::numeric_limits<double>::digits10);
+
+	char host[256] = "";
+	::gethostname(host, sizeof(host) - 1);
+
+	char        date[64] = "";
+	std::time_t now      = std::time(nullptr);
+	std::tm     tm{};
+	::localtime_r(&now, &tm);
+	std::strftime(date, sizeof(date), "%FT%T%z", &tm);
+
+	out << "{\n  \"context\": {\n    \"date\": ";
+	string(date) << ",\n    \"host_name\": ";
+	string(host) << ",\n    \"num_cpus\": " << std::thread::hardware_concurrency()
+	             << ",\n    \"mhz_per_cpu\": 0,\n    \"cpu_scaling_enabled\": false"
+	             << ",\n    \"caches\": [],\n    \"library_build_type\": ";
+#ifdef NDEBUG
+	string("release");
+#else
+	string("debug");
+#endif
+	out << "\n  },\n  \"benchmarks\": [";
+
+	bool first = true;
+	auto entry = [&](BenchmarkResult const& r, std::size_t family, std::string const& name,
+	                 char const* run_type, std::size_t repetitions, std::size_t index,
+	                 char const* aggregate, double real, double cpu) {
+		out << (first ? "\n" : ",\n") << "    {\"name\": ";
+		first = false;
+		string(name) << ", \"family_index\": " << family
+		             << ", \"per_family_instance_index\": 0, \"run_name\": ";
+		string(r.name) << ", \"run_type\": \"" << run_type
+		               << "\", \"repetitions\": " << repetitions;
+		if (nullptr == aggregate) {
+			out << ", \"repetition_index\": " << index;
+		}
+		out << ", \"threads\": 1";
+		if (nullptr != aggregate) {
+			out << ", \"aggregate_name\": \"" << aggregate
+			    << "\", \"aggregate_unit\": \"time\"";
+		}
+		out << ", \"iterations\": " << r.iterations << ", \"real_time\": ";
+		number(real) << ", \"cpu_time\": ";
+		number(cpu) << ", \"time_unit\": \"ns\"}";
+	};
+
+	for (std::size_t f{}; results_.size() > f; ++f) {
+		auto const& r = results_[f];
+		auto        n = r.repetitions.size() - r.numOutliers();
+
+		std::vector<double> cpu;
+		std::size_t         index{};
+		for (auto const& rep : r.repetitions) {
+			if (rep.outlier) {
+				continue;
+			}
+
+			double real_ns = std::chrono::duration<double, std::nano>(rep.real).count() /
+			                 static_cast<double>(r.iterations);
+			double cpu_ns  = std::chrono::duration<double, std::nano>(rep.cpu).count() /
+			                static_cast<double>(r.iterations);
+			cpu.push_back(cpu_ns);
+			entry(r, f, r.name, "iteration", n, index++, nullptr, real_ns, cpu_ns);
+		}
+
+		double cpu_mean = 0.0;
+		for (auto c : cpu) {
+			cpu_mean += c / static_cast<double>(cpu.size());
+		}
+		double cpu_var = 0.0;
+		for (auto c : cpu) {
+			cpu_var += (c - cpu_mean) * (c - cpu_mean) / std::max(1.0, cpu.size() - 1.0);
+		}
+
+		entry(r, f, r.name + "_mean", "aggregate", n, 0, "mean", 1e9 * r.mean, cpu_mean);
+		entry(r, f, r.name + "_median", "aggregate", n, 0, "median", 1e9 * r.median,
+		      median(cpu));
+		entry(r, f, r.name + "_stddev", "aggregate", n, 0, "stddev", 1e9 * r.std_dev,
+		      std::sqrt(cpu_var));
+	}
+
+	out << "\n  ]\n}\n";
+
+	out.flags(flags);
+	out.precision(prec);
+}
+
+//
+// Private functions
+//
+
+BenchmarkResult const& Benchmark::runImpl(std::string const&                      name,
+                                          std::function<void(std::size_t)> const& f)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	Pin pin(options_.cpu);
+
+	auto& res = results_.emplace_back();
+	res.name  = name;
+
+	auto start = Clock::now();
+	do {
+		f(1);
+	} while (Clock::now() - start < options_.warmup);
+
+	// The number of iterations that makes a repetition long enough, relative to the
+	// resolution of the clock and the overhead of reading it
+	res.iterations = 1;
+	while (true) {
+		auto s = Clock::now();
+		f(res.iterations);
+		if (Clock::now() - s >= options_.min_repetition_time ||
+		    std::numeric_limits<std::size_t>::max() / 2 < res.iterations) {
+			break;
+		}
+		res.iterations *= 2;
+	}
+
+	auto n     = static_cast<double>(res.iterations);
+	auto level = 0.5 + 0.5 * options_.confidence;
+
+	start = Clock::now();
+	while (options_.max_repetitions > res.repetitions.size()) {
+		auto cpu_start = threadCpuTime();
+		auto s         = Clock::now();
+		f(res.iterations);
+		auto e       = Clock::now();
+		auto cpu_end = threadCpuTime();
+		res.repetitions.push_back({e - s, cpu_end - cpu_start, false});
+
+		if (std::min(options_.min_repetitions, options_.max_repetitions) >
+		    res.repetitions.size()) {
+			continue;
+		}
+
+		// Reject outliers by their modified z-score
+		std::vector<double> times;
+		times.reserve(res.repetitions.size());
+		for (auto const& r : res.repetitions) {
+			times.push_back(std::chrono::duration<double>(r.real).count() / n);
+		}
+		double med = median(times);
+		std::vector<double> deviations;
+		deviations.reserve(times.size());
+		for (auto t : times) {
+			deviations.push_back(std::abs(t - med));
+		}
+		double mad = median(deviations);
+
+		res.timer = Timer();
+		std::vector<double> kept;
+		kept.reserve(times.size());
+		for (std::size_t i{}; times.size() > i; ++i) {
+			auto& r   = res.repetitions[i];
+			r.outlier = 0.0 < options_.outlier_threshold && 0.0 < mad &&
+			            options_.outlier_threshold < 0.6745 * std::abs(times[i] - med) / mad;
+			if (!r.outlier) {
+				res.timer.addSample(Clock::time_point(), Clock::time_point(r.real));
+				kept.push_back(times[i]);
+			}
+		}
+
+		auto k      = static_cast<double>(res.timer.numSamples());
+		res.mean    = res.timer.meanSeconds() / n;
+		res.std_dev = std::sqrt(res.timer.sampleVarianceSeconds()) / n;
+		res.median  = median(kept);
+
+		double half = 2.0 <= k ? studentTQuantile(level, k - 1.0) * res.std_dev / std::sqrt(k)
+		                       : std::numeric_limits<double>::infinity();
+		res.ci_low  = res.mean - half;
+		res.ci_high = res.mean + half;
+
+		res.converged = res.relativeError() <= options_.relative_error;
+		if (res.converged || Clock::now() - start >= options_.max_time) {
+			break;
+		}
+	}
+
+	return res;
+}
+}  // namespace ufo
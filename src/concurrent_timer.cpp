@@ -0,0 +1,57 @@
+// UFO
+#include <ufo/time/concurrent_timer.hpp>
+
+// STL
+#include <algorithm>
+
+namespace ufo
+{
+//
+// Public functions
+//
+
+ConcurrentTimer::ConcurrentTimer(std::size_t shards)
+{
+	if (0 == shards) {
+		shards = 2 * std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	std::size_t n = 1;
+	while (n < shards) {
+		n *= 2;
+	}
+
+	shards_ = std::make_unique<Shard[]>(n);
+	mask_   = n - 1;
+}
+
+Timer ConcurrentTimer::timer() const
+{
+	Timer ret;
+	for (std::size_t i{}; mask_ >= i; ++i) {
+		auto& s = shards_[i];
+		while (s.busy.exchange(true, std::memory_order_acquire)) {
+			std::this_thread::yield();
+		}
+		Timer t = s.timer;
+		s.busy.store(false, std::memory_order_release);
+
+		ret += t;
+	}
+	return ret;
+}
+
+void ConcurrentTimer::reset()
+{
+	for (std::size_t i{}; mask_ >= i; ++i) {
+		auto& s = shards_[i];
+		while (s.busy.exchange(true, std::memory_order_acquire)) {
+			std::this_thread::yield();
+		}
+		s.timer.reset();
+		s.busy.store(false, std::memory_order_release);
+	}
+}
+
+std::size_t ConcurrentTimer::numShards() const { return mask_ + 1; }
+}  // namespace ufo
@@ -0,0 +1,205 @@
+// UFO
+#include <ufo/time/dashboard.hpp>
+
+// STL
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace ufo
+{
+//
+// Public functions
+//
+
+Dashboard::Dashboard(Timing const& timing, std::string const& name)
+    : timing_(timing)
+    , name_(name)
+    , previous_time_(std::chrono::high_resolution_clock::now())
+{
+}
+
+Dashboard::Dashboard(Timing const& timing, std::ostream& out, std::string const& name)
+    : Dashboard(timing, name)
+{
+	out_ = &out;
+}
+
+Dashboard::~Dashboard() { stop(); }
+
+void Dashboard::showSeconds(std::chrono::milliseconds interval, int precision)
+{
+	show<std::chrono::seconds::period>(interval, precision);
+}
+
+void Dashboard::showMilliseconds(std::chrono::milliseconds interval, int precision)
+{
+	show<std::chrono::milliseconds::period>(interval, precision);
+}
+
+void Dashboard::showMicroseconds(std::chrono::milliseconds interval, int precision)
+{
+	show<std::chrono::microseconds::period>(interval, precision);
+}
+
+void Dashboard::showNanoseconds(std::chrono::milliseconds interval, int precision)
+{
+	show<std::chrono::nanoseconds::period>(interval, precision);
+}
+
+void Dashboard::drawSeconds(int precision)
+{
+	draw<std::chrono::seconds::period>(precision);
+}
+
+void Dashboard::drawMilliseconds(int precision)
+{
+	draw<std::chrono::milliseconds::period>(precision);
+}
+
+void Dashboard::drawMicroseconds(int precision)
+{
+	draw<std::chrono::microseconds::period>(precision);
+}
+
+void Dashboard::drawNanoseconds(int precision)
+{
+	draw<std::chrono::nanoseconds::period>(precision);
+}
+
+void Dashboard::stop()
+{
+	{
+		std::lock_guard lock(mutex_);
+		running_ = false;
+	}
+	cv_.notify_all();
+
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+}
+
+bool Dashboard::showing() const { return running_; }
+
+//
+// Private functions
+//
+
+void Dashboard::show(std::chrono::milliseconds interval, int precision, Unit unit)
+{
+	if (thread_.joinable()) {
+		return;
+	}
+
+	running_ = true;
+	thread_  = std::thread([this, interval, precision, unit]() {
+		// Start from a clear screen, later redraws overwrite the table
+		write("\033[2J");
+
+		std::unique_lock lock(mutex_);
+		while (running_) {
+			lock.unlock();
+			draw(precision, unit);
+			lock.lock();
+			cv_.wait_for(lock, interval, [this]() { return !running_; });
+		}
+	});
+}
+
+void Dashboard::draw(int precision, Unit const& unit)
+{
+	std::lock_guard lock(draw_mutex_);
+
+	TimingSnapshot current(timing_);
+	// The change since the previous redraw
+	auto delta = current - previous_;
+	auto dt    = std::chrono::duration<double>(current.time() - previous_time_).count();
+
+	struct Row {
+		int                   level;
+		TimingSnapshot const* node;
+		TimingSnapshot const* delta;
+	};
+
+	std::vector<Row> rows;
+	auto add = [&rows](auto& self, TimingSnapshot const& node, TimingSnapshot const& delta,
+	                   int level) -> void {
+		rows.push_back({level, &node, &delta});
+
+		std::vector<std::pair<TimingSnapshot const*, TimingSnapshot const*>> children;
+		for (auto const& [tag, child] : node.children()) {
+			children.emplace_back(&child, &delta[tag]);
+		}
+		// Hottest first
+		std::stable_sort(std::begin(children), std::end(children),
+		                 [](auto const& a, auto const& b) {
+			                 return a.second->timer().totalSeconds() >
+			                        b.second->timer().totalSeconds();
+		                 });
+
+		for (auto const& [child, child_delta] : children) {
+			self(self, *child, *child_delta, level + 1);
+		}
+	};
+	add(add, current, delta, 0);
+
+	auto const& root  = delta.timer();
+	double      frame = 0 < root.numSamples() ? root.totalSeconds() : dt;
+
+	std::vector<std::pair<int, std::string>> tags;
+	std::vector<std::string>                 colors;
+	std::vector<std::vector<std::wstring>>   columns{
+	      {L" Samples/s "}, {L" " + unit.short_name + L"/s "}, {L" Frame % "},
+	      {L" Mean "},      {L" Total "},                      {L" Samples "}};
+
+	auto fixed = [precision](double value) {
+		std::wstringstream ss;
+		ss << std::fixed << std::setprecision(precision) << L' ' << value << L' ';
+		return ss.str();
+	};
+
+	auto nan = std::numeric_limits<double>::quiet_NaN();
+	for (auto const& r : rows) {
+		tags.emplace_back(r.level, r.node->tag());
+		colors.push_back(r.node->color());
+
+		auto samples = r.delta->timer().numSamples();
+		auto total   = r.delta->timer().totalSeconds();
+
+		columns[0].push_back(0 < dt ? Timing::siPrefixed(samples / dt, precision) : L" nan ");
+		columns[1].push_back(fixed(0 < dt ? total / unit.seconds / dt : nan));
+		columns[2].push_back(fixed(0 < frame ? 100 * total / frame : nan));
+		columns[3].push_back(fixed(0 < samples ? total / samples / unit.seconds : nan));
+		columns[4].push_back(fixed(r.node->timer().totalSeconds() / unit.seconds));
+		columns[5].push_back(L" " + std::to_wstring(r.node->timer().numSamples()) + L" ");
+	}
+
+	std::vector<std::pair<std::wstring, std::wstring>> component{{L" Component ", L""}};
+	Timing::addTags(component, tags);
+
+	// Overwrite the previous table instead of scrolling
+	std::ostringstream table;
+	table << "\033[H";
+	std::string title = name_.empty() ? current.tag() + " live" : name_;
+	Timing::printTable(table, Timing::header(title, unit.name), component, colors, columns,
+	                   false);
+	table << "\033[J";
+	write(table.str());
+
+	previous_      = std::move(current);
+	previous_time_ = previous_.time();
+}
+
+void Dashboard::write(std::string const& str)
+{
+	if (nullptr != out_) {
+		*out_ << str << std::flush;
+	} else {
+		std::fputs(str.c_str(), stdout);
+		std::fflush(stdout);
+	}
+}
+}  // namespace ufo
@@ -0,0 +1,123 @@
+// UFO
+#include <ufo/time/flat_profile.hpp>
+
+// STL
+#include <algorithm>
+
+namespace ufo
+{
+//
+// Public functions
+//
+
+FlatProfile::FlatProfile(Timing const& timing)
+{
+	bool timed;
+	{
+		std::lock_guard lock(timing.mutex_);
+		timed = 0 < timing.timer_.numSamples();
+	}
+
+	// The root is only included if it has been timed
+	std::vector<std::string> ancestors;
+	if (timed) {
+		addRecurs(timing, "", ancestors);
+	} else {
+		std::lock_guard lock(timing.mutex_);
+		for (auto const& [_, child] : timing.children_) {
+			addRecurs(child, timing.tag_, ancestors);
+		}
+	}
+
+	for (auto& e : entries_) {
+		std::sort(std::begin(e.parents), std::end(e.parents),
+		          [](auto const& a, auto const& b) { return a.second > b.second; });
+		total_ += e.exclusive;
+	}
+	std::stable_sort(
+	    std::begin(entries_), std::end(entries_),
+	    [](Entry const& a, Entry const& b) { return a.exclusive > b.exclusive; });
+	for (std::size_t i{}; entries_.size() > i; ++i) {
+		index_[entries_[i].tag] = i;
+	}
+}
+
+std::vector<FlatProfile::Entry> const& FlatProfile::entries() const { return entries_; }
+
+FlatProfile::Entry const* FlatProfile::find(std::string const& tag) const
+{
+	auto it = index_.find(tag);
+	return std::end(index_) == it ? nullptr : &entries_[it->second];
+}
+
+double FlatProfile::total() const { return total_; }
+
+void FlatProfile::printSeconds(std::string const& name, std::size_t parents,
+                               int precision) const
+{
+	print<std::chrono::seconds::period>(name, parents, precision);
+}
+
+void FlatProfile::printMilliseconds(std::string const& name, std::size_t parents,
+                                    int precision) const
+{
+	print<std::chrono::milliseconds::period>(name, parents, precision);
+}
+
+void FlatProfile::printMicroseconds(std::string const& name, std::size_t parents,
+                                    int precision) const
+{
+	print<std::chrono::microseconds::period>(name, parents, precision);
+}
+
+void FlatProfile::printNanoseconds(std::string const& name, std::size_t parents,
+                                   int precision) const
+{
+	print<std::chrono::nanoseconds::period>(name, parents, precision);
+}
+
+//
+// Private functions
+//
+
+void FlatProfile::addRecurs(Timing const& timing, std::string const& parent,
+                            std::vector<std::string>& ancestors)
+{
+	std::lock_guard lock(timing.mutex_);
+
+	auto [it, added] = index_.try_emplace(timing.tag_, entries_.size());
+	if (added) {
+		entries_.emplace_back().tag = timing.tag_;
+	}
+	auto& e = entries_[it->second];
+
+	auto exclusive = timing.timer_.totalSeconds();
+	for (auto const& [_, child] : timing.children_) {
+		std::lock_guard child_lock(child.mutex_);
+		exclusive -= child.timer_.totalSeconds();
+	}
+	e.exclusive += std::max(0.0, exclusive);
+	e.calls += timing.timer_.numSamples();
+
+	// Recursive occurrences are already part of the inclusive time of the outermost
+	if (std::end(ancestors) == std::find(std::begin(ancestors), std::end(ancestors),
+	                                     timing.tag_)) {
+		e.inclusive += timing.timer_;
+		if (!parent.empty()) {
+			auto p = std::find_if(std::begin(e.parents), std::end(e.parents),
+			                      [&parent](auto const& q) { return q.first == parent; });
+			if (std::end(e.parents) == p) {
+				e.parents.emplace_back(parent, timing.timer_.totalSeconds());
+			} else {
+				p->second += timing.timer_.totalSeconds();
+			}
+		}
+	}
+
+	ancestors.push_back(timing.tag_);
+	for (auto const& [_, child] : timing.children_) {
+		addRecurs(child, timing.tag_, ancestors);
+	}
+	ancestors.pop_back();
+}
+}  // namespace ufo
@@ -0,0 +1,69 @@
+// UFO
+#include <ufo/time/handoff.hpp>
+
+namespace ufo
+{
+//
+// Public functions
+//
+
+Handoff::Handoff() : Handoff(std::chrono::high_resolution_clock::now()) {}
+
+Handoff::Handoff(std::chrono::time_point<std::chrono::high_resolution_clock> origin)
+    : origin_(origin), last_lap_(origin)
+{
+}
+
+Handoff& Handoff::lap(Timing& timing)
+{
+	auto now = std::chrono::high_resolution_clock::now();
+	timing.addSample(last_lap_, now);
+	last_lap_ = now;
+	return *this;
+}
+
+Handoff& Handoff::lap(Timer& timer)
+{
+	auto now = std::chrono::high_resolution_clock::now();
+	timer.addSample(last_lap_, now);
+	last_lap_ = now;
+	return *this;
+}
+
+void Handoff::finish(Timing& timing) const
+{
+	timing.addSample(origin_, std::chrono::high_resolution_clock::now());
+}
+
+void Handoff::finish(Timer& timer) const
+{
+	timer.addSample(origin_, std::chrono::high_resolution_clock::now());
+}
+
+std::chrono::time_point<std::chrono::high_resolution_clock> Handoff::origin() const
+{
+	return origin_;
+}
+
+std::chrono::time_point<std::chrono::high_resolution_clock> Handoff::lastLap() const
+{
+	return last_lap_;
+}
+
+double Handoff::elapsedSeconds() const { return elapsed<std::chrono::seconds::period>(); }
+
+double Handoff::elapsedMilliseconds() const
+{
+	return elapsed<std::chrono::milliseconds::period>();
+}
+
+double Handoff::elapsedMicroseconds() const
+{
+	return elapsed<std::chrono::microseconds::period>();
+}
+
+double Handoff::elapsedNanoseconds() const
+{
+	return elapsed<std::chrono::nanoseconds::period>();
+}
+}  // namespace ufo
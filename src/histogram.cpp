@@ -0,0 +1,153 @@
+// UFO
+#include <ufo/time/histogram.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+namespace ufo
+{
+//
+// Public functions
+//
+
+void Histogram::add(std::chrono::high_resolution_clock::duration duration,
+                    std::uint64_t                                count)
+{
+	auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+	auto i  = index(0 > ns ? 0 : static_cast<std::uint64_t>(ns));
+	if (counts_.size() <= i) {
+		counts_.resize(i + 1, 0);
+	}
+	counts_[i] += count;
+	count_ += count;
+}
+
+void Histogram::reset()
+{
+	counts_.clear();
+	count_ = 0;
+}
+
+Histogram& Histogram::operator+=(Histogram const& rhs)
+{
+	if (counts_.size() < rhs.counts_.size()) {
+		counts_.resize(rhs.counts_.size(), 0);
+	}
+	for (std::size_t i{}; rhs.counts_.size() > i; ++i) {
+		counts_[i] += rhs.counts_[i];
+	}
+	count_ += rhs.count_;
+	return *this;
+}
+
+Histogram operator+(Histogram lhs, Histogram const& rhs)
+{
+	lhs += rhs;
+	return lhs;
+}
+
+std::uint64_t Histogram::count() const { return count_; }
+
+bool Histogram::empty() const { return 0 == count_; }
+
+std::size_t Histogram::memoryUsage() const
+{
+	return counts_.capacity() * sizeof(std::uint64_t);
+}
+
+double Histogram::percentileSeconds(double p) const
+{
+	return percentile<std::chrono::seconds::period>(p);
+}
+
+double Histogram::percentileMilliseconds(double p) const
+{
+	return percentile<std::chrono::milliseconds::period>(p);
+}
+
+double Histogram::percentileMicroseconds(double p) const
+{
+	return percentile<std::chrono::microseconds::period>(p);
+}
+
+double Histogram::percentileNanoseconds(double p) const
+{
+	return percentile<std::chrono::nanoseconds::period>(p);
+}
+
+std::vector<std::tuple<std::chrono::high_resolution_clock::duration,
+                       std::chrono::high_resolution_clock::duration, std::uint64_t>>
+Histogram::buckets() const
+{
+	std::vector<std::tuple<std::chrono::high_resolution_clock::duration,
+	                       std::chrono::high_resolution_clock::duration, std::uint64_t>>
+	    res;
+	for (std::size_t i{}; counts_.size() > i; ++i) {
+		if (0 != counts_[i]) {
+			auto lower = std::chrono::nanoseconds(lowerBound(i));
+			res.emplace_back(lower, lower + std::chrono::nanoseconds(width(i)), counts_[i]);
+		}
+	}
+	return res;
+}
+
+//
+// Private functions
+//
+
+std::chrono::high_resolution_clock::duration Histogram::percentileDuration(double p) const
+{
+	auto rank = static_cast<std::uint64_t>(
+	    std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(count_)));
+	rank = std::max(rank, std::uint64_t(1));
+
+	std::uint64_t cumulative{};
+	std::size_t   i{};
+	for (; counts_.size() > i; ++i) {
+		cumulative += counts_[i];
+		if (rank <= cumulative) {
+			break;
+		}
+	}
+
+	// Middle of the bucket
+	return std::chrono::nanoseconds(lowerBound(i) + width(i) / 2);
+}
+
+std::size_t Histogram::index(std::uint64_t value)
+{
+	constexpr std::uint64_t sub = std::uint64_t(1) << SUB_BITS;
+	if (sub > value) {
+		return value;
+	}
+
+	int e = 63;
+	while (0 == (value >> e)) {
+		--e;
+	}
+	return (e - SUB_BITS + 1) * sub + ((value >> (e - SUB_BITS)) & (sub - 1));
+}
+
+std::uint64_t Histogram::lowerBound(std::size_t index)
+{
+	constexpr std::uint64_t sub = std::uint64_t(1) << SUB_BITS;
+	if (sub > index) {
+		return index;
+	}
+
+	int e = static_cast<int>(index / sub) + SUB_BITS - 1;
+	return (sub + index % sub) << (e - SUB_BITS);
+}
+
+std::uint64_t Histogram::width(std::size_t index)
+{
+	constexpr std::uint64_t sub = std::uint64_t(1) << SUB_BITS;
+	if (sub > index) {
+		return 1;
+	}
+
+	int e = static_cast<int>(index / sub) + SUB_BITS - 1;
+	return std::uint64_t(1) << (e - SUB_BITS);
+}
+}  // namespace ufo
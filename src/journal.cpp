@@ -0,0 +1,585 @@
+// UFO
+#include <ufo/time/journal.hpp>
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <algorithm>
+#include <cstring>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ufo
+{
+namespace
+{
+// File header
+constexpr char          MAGIC[8] = {'U', 'F', 'O', 'J', 'R', 'N', 'L', '1'};
+constexpr std::uint32_t VERSION  = 1;
+// Offsets in the file header
+constexpr std::size_t VERSION_OFFSET       = 8;
+constexpr std::size_t HEADER_SIZE_OFFSET   = 12;
+constexpr std::size_t CHUNK_SIZE_OFFSET    = 16;
+constexpr std::size_t PERIOD_NUM_OFFSET    = 24;
+constexpr std::size_t PERIOD_DEN_OFFSET    = 32;
+constexpr std::size_t SYSTEM_ORIGIN_OFFSET = 40;
+constexpr std::size_t CLOCK_ORIGIN_OFFSET  = 48;
+
+// Offsets in the chunk header
+constexpr std::uint32_t CHUNK_MAGIC         = 0x43464F55;  // "UFOC"
+constexpr std::size_t   CHUNK_THREAD_OFFSET = 4;
+constexpr std::size_t   CHUNK_BASE_OFFSET   = 8;
+constexpr std::size_t   CHUNK_USED_OFFSET   = 16;
+
+// The record kind is in the two lowest bits of the first varint, the node id above
+enum Kind : std::uint64_t { START = 0, STOP = 1, NODE = 2 };
+
+constexpr std::size_t MAX_VARINT_SIZE = 10;
+
+std::atomic<std::uint64_t> next_serial{1};
+
+template <class T>
+void store(unsigned char* p, T value)
+{
+	std::memcpy(p, &value, sizeof(T));
+}
+
+template <class T>
+T load(unsigned char const* p)
+{
+	T value;
+	std::memcpy(&value, p, sizeof(T));
+	return value;
+}
+
+std::size_t putVarint(unsigned char* out, std::uint64_t value)
+{
+	std::size_t n{};
+	for (; 0x80 <= value; value >>= 7) {
+		out[n++] = static_cast<unsigned char>(value | 0x80);
+	}
+	out[n++] = static_cast<unsigned char>(value);
+	return n;
+}
+
+bool getVarint(unsigned char const*& p, unsigned char const* end, std::uint64_t& value)
+{
+	value = 0;
+	for (int shift{}; end != p && 64 > shift; shift += 7) {
+		auto b = *p++;
+		value |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+		if (0 == (b & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+std::uint64_t zigzag(std::int64_t value)
+{
+	return (static_cast<std::uint64_t>(value) << 1) ^
+	       static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value)
+{
+	return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+// Calls `f(index)` for each index in [0, n) from `num_threads` threads
+template <class F>
+void parallelFor(std::size_t n, unsigned num_threads, F f)
+{
+	std::atomic<std::size_t> next{0};
+	auto                     work = [&] {
+		for (auto i = next++; n > i; i = next++) {
+			f(i);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (unsigned i = 1; std::min<std::size_t>(std::max(1u, num_threads), n) > i; ++i) {
+		threads.emplace_back(work);
+	}
+	work();
+	for (auto& t : threads) {
+		t.join();
+	}
+}
+}  // namespace
+
+//
+// Public functions
+//
+
+Journal::Journal(std::string const& path, std::size_t chunk_size)
+    : path_(path), serial_(next_serial++)
+{
+	header_size_ = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	chunk_size_ = (chunk_size + header_size_ - 1) / header_size_ * header_size_;
+	chunk_size_ = std::max(header_size_, chunk_size_);
+	file_size_ = header_size_;
+
+	fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (0 > fd_) {
+		return;
+	}
+
+	auto system = std::chrono::system_clock::now();
+	auto clock  = std::chrono::high_resolution_clock::now();
+
+	std::vector<unsigned char> header(header_size_);
+	std::memcpy(header.data(), MAGIC, sizeof(MAGIC));
+	store(header.data() + VERSION_OFFSET, VERSION);
+	store(header.data() + HEADER_SIZE_OFFSET, static_cast<std::uint32_t>(header_size_));
+	store(header.data() + CHUNK_SIZE_OFFSET, static_cast<std::uint64_t>(chunk_size_));
+	store(header.data() + PERIOD_NUM_OFFSET,
+	      static_cast<std::int64_t>(std::chrono::high_resolution_clock::period::num));
+	store(header.data() + PERIOD_DEN_OFFSET,
+	      static_cast<std::int64_t>(std::chrono::high_resolution_clock::period::den));
+	store(header.data() + SYSTEM_ORIGIN_OFFSET,
+	      static_cast<std::int64_t>(
+	          std::chrono::duration_cast<std::chrono::nanoseconds>(system.time_since_epoch())
+	              .count()));
+	store(header.data() + CLOCK_ORIGIN_OFFSET,
+	      static_cast<std::int64_t>(clock.time_since_epoch().count()));
+
+	if (static_cast<ssize_t>(header.size()) !=
+	    ::pwrite(fd_, header.data(), header.size(), 0)) {
+		::close(fd_);
+		fd_ = -1;
+	}
+}
+
+Journal::~Journal()
+{
+	for (auto& [_, w] : writers_) {
+		if (nullptr != w->chunk) {
+			::munmap(w->chunk, chunk_size_);
+		}
+	}
+
+	if (0 <= fd_) {
+		::close(fd_);
+	}
+}
+
+bool Journal::isOpen() const { return 0 <= fd_; }
+
+std::string const& Journal::path() const { return path_; }
+
+void Journal::flush()
+{
+	std::lock_guard lock(mutex_);
+	for (auto& [_, w] : writers_) {
+		if (nullptr != w->chunk) {
+			::msync(w->chunk, chunk_size_, MS_SYNC);
+		}
+	}
+
+	if (0 <= fd_) {
+		::fsync(fd_);
+	}
+}
+
+JournalReader::JournalReader(std::string const& path)
+{
+	fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (0 > fd_) {
+		return;
+	}
+
+	struct stat st;
+	if (0 != ::fstat(fd_, &st) ||
+	    CLOCK_ORIGIN_OFFSET + 8 > static_cast<std::size_t>(st.st_size)) {
+		::close(fd_);
+		fd_ = -1;
+		return;
+	}
+
+	size_   = static_cast<std::size_t>(st.st_size);
+	void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+	if (MAP_FAILED == p) {
+		::close(fd_);
+		fd_ = -1;
+		return;
+	}
+	data_ = static_cast<unsigned char const*>(p);
+
+	bool valid =
+	    0 == std::memcmp(data_, MAGIC, sizeof(MAGIC)) &&
+	    VERSION == load<std::uint32_t>(data_ + VERSION_OFFSET) &&
+	    std::chrono::high_resolution_clock::period::num ==
+	        load<std::int64_t>(data_ + PERIOD_NUM_OFFSET) &&
+	    std::chrono::high_resolution_clock::period::den ==
+	        load<std::int64_t>(data_ + PERIOD_DEN_OFFSET);
+
+	header_size_   = load<std::uint32_t>(data_ + HEADER_SIZE_OFFSET);
+	chunk_size_    = load<std::uint64_t>(data_ + CHUNK_SIZE_OFFSET);
+	system_origin_ = load<std::int64_t>(data_ + SYSTEM_ORIGIN_OFFSET);
+	clock_origin_  = load<std::int64_t>(data_ + CLOCK_ORIGIN_OFFSET);
+
+	if (!valid || header_size_ > size_ || Journal::CHUNK_HEADER_SIZE > chunk_size_) {
+		::munmap(const_cast<unsigned char*>(data_), size_);
+		::close(fd_);
+		data_ = nullptr;
+		fd_   = -1;
+	}
+}
+
+JournalReader::~JournalReader()
+{
+	if (nullptr != data_) {
+		::munmap(const_cast<unsigned char*>(data_), size_);
+	}
+
+	if (0 <= fd_) {
+		::close(fd_);
+	}
+}
+
+bool JournalReader::isOpen() const { return 0 <= fd_; }
+
+std::size_t JournalReader::numChunks() const
+{
+	// A chunk cut off by the end of the file is not used
+	return isOpen() ? (size_ - header_size_) / chunk_size_ : 0;
+}
+
+std::chrono::system_clock::time_point JournalReader::toSystemTime(
+    std::chrono::time_point<std::chrono::high_resolution_clock> time) const
+{
+	auto since_origin =
+	    time - std::chrono::time_point<std::chrono::high_resolution_clock>(
+	               std::chrono::high_resolution_clock::duration(clock_origin_));
+	return std::chrono::system_clock::time_point(
+	    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+	        std::chrono::nanoseconds(system_origin_) + since_origin));
+}
+
+std::size_t JournalReader::read(
+    Timing& timing, std::chrono::time_point<std::chrono::high_resolution_clock> first,
+    std::chrono::time_point<std::chrono::high_resolution_clock> last,
+    unsigned                                                    num_threads) const
+{
+	using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+	auto n = numChunks();
+
+	// Bytes of records in the chunk, zero if the chunk was never written
+	auto records = [this](std::size_t index) {
+		using Range = std::pair<unsigned char const*, std::size_t>;
+		auto c      = chunk(index);
+		if (CHUNK_MAGIC != load<std::uint32_t>(c)) {
+			return Range(nullptr, 0);
+		}
+		auto used = load<std::uint32_t>(c + CHUNK_USED_OFFSET);
+		return Range(c + Journal::CHUNK_HEADER_SIZE,
+		             std::min<std::size_t>(used, chunk_size_ - Journal::CHUNK_HEADER_SIZE));
+	};
+
+	// First pass, the node definitions and which chunks belong to which thread
+	std::mutex                                       mutex;
+	std::vector<Journal::Definition>                 definitions;
+	std::map<std::uint32_t, std::vector<std::size_t>> thread_chunks;
+
+	parallelFor(n, num_threads, [&](std::size_t index) {
+		auto [p, size] = records(index);
+		if (nullptr == p) {
+			return;
+		}
+
+		std::vector<Journal::Definition> defs;
+		for (auto end = p + size; end != p;) {
+			std::uint64_t v;
+			std::uint64_t w;
+			if (!getVarint(p, end, v) || !getVarint(p, end, w)) {
+				break;
+			}
+			if (NODE != (v & 3)) {
+				continue;
+			}
+
+			std::uint64_t length;
+			if (!getVarint(p, end, length) || static_cast<std::size_t>(end - p) < length) {
+				break;
+			}
+			defs.push_back({static_cast<std::uint32_t>(v >> 2), static_cast<std::uint32_t>(w),
+			                std::string(reinterpret_cast<char const*>(p), length)});
+			p += length;
+		}
+
+		std::lock_guard lock(mutex);
+		definitions.insert(std::end(definitions), std::begin(defs), std::end(defs));
+		thread_chunks[load<std::uint32_t>(chunk(index) + CHUNK_THREAD_OFFSET)].push_back(index);
+	});
+
+	// The nodes of `timing`, created in id order so parents come first
+	std::sort(std::begin(definitions), std::end(definitions),
+	          [](auto const& a, auto const& b) { return a.id < b.id; });
+	std::vector<Timing*> nodes(definitions.empty() ? 0 : definitions.back().id + 1, nullptr);
+	for (auto const& d : definitions) {
+		if (0 == d.parent) {
+			nodes[d.id] = &timing;
+		} else if (d.parent <= nodes.size() && nullptr != nodes[d.parent - 1]) {
+			nodes[d.id] = &(*nodes[d.parent - 1])[d.tag];
+		}
+	}
+
+	// Second pass, replay the events of each thread
+	std::vector<std::pair<std::uint32_t, std::vector<std::size_t>>> threads(
+	    std::begin(thread_chunks), std::end(thread_chunks));
+	std::atomic<std::size_t> num_intervals{0};
+
+	parallelFor(threads.size(), num_threads, [&](std::size_t index) {
+		auto& chunks = threads[index].second;
+		// Chunks are allocated in order, so this is the order they were written in
+		std::sort(std::begin(chunks), std::end(chunks));
+
+		std::vector<std::pair<std::uint32_t, std::int64_t>> stack;
+		std::size_t                                         count{};
+		for (auto c : chunks) {
+			auto [p, size] = records(c);
+			auto time      = load<std::int64_t>(chunk(c) + CHUNK_BASE_OFFSET);
+			for (auto end = p + size; end != p;) {
+				std::uint64_t v;
+				std::uint64_t w;
+				if (!getVarint(p, end, v) || !getVarint(p, end, w)) {
+					break;
+				}
+
+				auto id = static_cast<std::uint32_t>(v >> 2);
+				if (NODE == (v & 3)) {
+					std::uint64_t length;
+					if (!getVarint(p, end, length) || static_cast<std::size_t>(end - p) < length) {
+						break;
+					}
+					p += length;
+					continue;
+				}
+
+				time += unzigzag(w);
+				if (START == (v & 3)) {
+					stack.emplace_back(id, time);
+					continue;
+				}
+
+				// Events lost in a crash leave unmatched starts behind, skip them
+				while (!stack.empty() && id != stack.back().first) {
+					stack.pop_back();
+				}
+				if (stack.empty()) {
+					continue;
+				}
+
+				TimePoint start{std::chrono::high_resolution_clock::duration(stack.back().second)};
+				TimePoint stop{std::chrono::high_resolution_clock::duration(time)};
+				stack.pop_back();
+
+				if (first <= start && stop <= last && nodes.size() > id && nullptr != nodes[id]) {
+					nodes[id]->addSample(start, stop);
+					++count;
+				}
+			}
+		}
+
+		num_intervals += count;
+	});
+
+	return num_intervals;
+}
+
+//
+// Private functions
+//
+
+void Journal::start(Timing const&                                               node,
+                    std::chrono::time_point<std::chrono::high_resolution_clock> time)
+{
+	event(node, time, false);
+}
+
+void Journal::stop(Timing const&                                               node,
+                   std::chrono::time_point<std::chrono::high_resolution_clock> time)
+{
+	event(node, time, true);
+}
+
+void Journal::event(Timing const&                                               node,
+                    std::chrono::time_point<std::chrono::high_resolution_clock> time,
+                    bool                                                        stop)
+{
+	if (!isOpen()) {
+		return;
+	}
+
+	auto& w  = writer();
+	auto  id = this->id(w, node);
+	auto  p  = reserve(w, 2 * MAX_VARINT_SIZE);
+	if (nullptr == p) {
+		return;
+	}
+
+	std::int64_t t = time.time_since_epoch().count();
+	auto         v = static_cast<std::uint64_t>(id) << 2 | (stop ? STOP : START);
+	std::size_t  n = putVarint(p, v);
+	n += putVarint(p + n, zigzag(t - w.last));
+	w.last = t;
+	commit(w, n);
+}
+
+Journal::Writer& Journal::writer()
+{
+	thread_local std::uint64_t serial = 0;
+	thread_local Writer*       cached = nullptr;
+
+	if (serial_ == serial) {
+		return *cached;
+	}
+
+	std::lock_guard lock(mutex_);
+	auto&           w = writers_[std::this_thread::get_id()];
+	if (!w) {
+		w         = std::make_unique<Writer>();
+		w->thread = static_cast<std::uint32_t>(writers_.size() - 1);
+	}
+
+	serial = serial_;
+	cached = w.get();
+	return *w;
+}
+
+std::uint32_t Journal::id(Writer& w, Timing const& node)
+{
+	if (auto g = generation_.load(std::memory_order_acquire); w.generation != g) {
+		w.ids.clear();
+		w.generation = g;
+	}
+
+	if (auto it = w.ids.find(&node); std::end(w.ids) != it) {
+		return it->second;
+	}
+
+	std::vector<Definition> definitions;
+	std::uint32_t           res;
+	{
+		std::lock_guard lock(mutex_);
+		define(node, definitions);
+		res = ids_.at(&node);
+	}
+
+	// Written after releasing the lock, starting a chunk takes it
+	for (auto it = std::begin(definitions); std::end(definitions) != it; ++it) {
+		auto const& d = *it;
+		auto        p = reserve(w, 3 * MAX_VARINT_SIZE + d.tag.size());
+		if (nullptr == p) {
+			// The nodes not written are defined again by the next event, as events referring
+			// to an undefined node are dropped by the reader
+			std::lock_guard lock(mutex_);
+			for (; std::end(definitions) != it; ++it) {
+				if (auto id = ids_.find(it->node); std::end(ids_) != id && it->id == id->second) {
+					ids_.erase(id);
+				}
+			}
+			generation_.fetch_add(1, std::memory_order_release);
+			return res;
+		}
+
+		std::size_t n = putVarint(p, static_cast<std::uint64_t>(d.id) << 2 | NODE);
+		n += putVarint(p + n, d.parent);
+		n += putVarint(p + n, d.tag.size());
+		std::memcpy(p + n, d.tag.data(), d.tag.size());
+		commit(w, n + d.tag.size());
+	}
+
+	w.ids.emplace(&node, res);
+	return res;
+}
+
+void Journal::define(Timing const& node, std::vector<Definition>& definitions)
+{
+	if (0 < ids_.count(&node)) {
+		return;
+	}
+
+	std::uint32_t parent{};
+	if (nullptr != node.parent_) {
+		define(*node.parent_, definitions);
+		parent = ids_.at(node.parent_) + 1;
+	}
+
+	auto id     = next_id_++;
+	ids_[&node] = id;
+	definitions.push_back({id, parent, node.tag_, &node});
+}
+
+void Journal::forget(Timing const& node)
+{
+	std::lock_guard lock(mutex_);
+	if (0 < ids_.erase(&node)) {
+		generation_.fetch_add(1, std::memory_order_release);
+	}
+}
+
+unsigned char* Journal::reserve(Writer& w, std::size_t size)
+{
+	if (chunk_size_ < CHUNK_HEADER_SIZE + size) {
+		return nullptr;
+	}
+
+	if ((nullptr == w.chunk || chunk_size_ < w.offset + size) && !newChunk(w)) {
+		return nullptr;
+	}
+
+	return w.chunk + w.offset;
+}
+
+void Journal::commit(Writer& w, std::size_t size)
+{
+	w.offset += size;
+	// The record has to be in place before it is counted as used
+	std::atomic_thread_fence(std::memory_order_release);
+	store(w.chunk + CHUNK_USED_OFFSET,
+	      static_cast<std::uint32_t>(w.offset - CHUNK_HEADER_SIZE));
+}
+
+bool Journal::newChunk(Writer& w)
+{
+	std::lock_guard lock(mutex_);
+
+	if (nullptr != w.chunk) {
+		::munmap(w.chunk, chunk_size_);
+		w.chunk = nullptr;
+	}
+
+	if (0 != ::ftruncate(fd_, static_cast<off_t>(file_size_ + chunk_size_))) {
+		return false;
+	}
+
+	void* p = ::mmap(nullptr, chunk_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_,
+	                 static_cast<off_t>(file_size_));
+	if (MAP_FAILED == p) {
+		return false;
+	}
+	file_size_ += chunk_size_;
+
+	w.chunk  = static_cast<unsigned char*>(p);
+	w.offset = CHUNK_HEADER_SIZE;
+	w.last   = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+	store(w.chunk, CHUNK_MAGIC);
+	store(w.chunk + CHUNK_THREAD_OFFSET, w.thread);
+	store(w.chunk + CHUNK_BASE_OFFSET, w.last);
+	store(w.chunk + CHUNK_USED_OFFSET, std::uint32_t(0));
+
+	return true;
+}
+
+unsigned char const* JournalReader::chunk(std::size_t index) const
+{
+	return data_ + header_size_ + index * chunk_size_;
+}
+}  // namespace ufo
@@ -0,0 +1,183 @@
+// UFO
+#include <ufo/time/open_metrics_exporter.hpp>
+
+// STL
+#include <cstdio>
+#include <fstream>
+
+// POSIX
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ufo
+{
+//
+// Public functions
+//
+
+OpenMetricsExporter::OpenMetricsExporter(Timing const& timing, std::string const& prefix)
+    : timing_(timing), prefix_(prefix)
+{
+}
+
+OpenMetricsExporter::~OpenMetricsExporter() { stop(); }
+
+bool OpenMetricsExporter::write(std::string const& path) const
+{
+	std::string tmp = path + ".tmp";
+	{
+		std::ofstream file(tmp, std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+		timing_.writeOpenMetrics(file, prefix_);
+		if (!file.flush()) {
+			return false;
+		}
+	}
+	return 0 == std::rename(tmp.c_str(), path.c_str());
+}
+
+void OpenMetricsExporter::writePeriodically(std::string const&        path,
+                                            std::chrono::milliseconds interval)
+{
+	if (file_thread_.joinable()) {
+		return;
+	}
+
+	{
+		std::lock_guard lock(mutex_);
+		running_ = true;
+	}
+	file_thread_ = std::thread([this, path, interval]() {
+		std::unique_lock lock(mutex_);
+		while (running_) {
+			lock.unlock();
+			write(path);
+			lock.lock();
+			cv_.wait_for(lock, interval, [this]() { return !running_; });
+		}
+	});
+}
+
+bool OpenMetricsExporter::serve(std::uint16_t port)
+{
+	if (http_thread_.joinable()) {
+		return true;
+	}
+
+	int s = ::socket(AF_INET, SOCK_STREAM, 0);
+	if (0 > s) {
+		return false;
+	}
+
+	int yes = 1;
+	::setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+	sockaddr_in addr{};
+	addr.sin_family      = AF_INET;
+	addr.sin_port        = htons(port);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if (0 > ::bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) ||
+	    0 > ::listen(s, 8)) {
+		::close(s);
+		return false;
+	}
+
+	{
+		std::lock_guard lock(mutex_);
+		running_ = true;
+	}
+	http_thread_ = std::thread(&OpenMetricsExporter::serveLoop, this, s);
+	return true;
+}
+
+void OpenMetricsExporter::stop()
+{
+	{
+		std::lock_guard lock(mutex_);
+		running_ = false;
+	}
+	cv_.notify_all();
+
+	if (file_thread_.joinable()) {
+		file_thread_.join();
+	}
+	if (http_thread_.joinable()) {
+		http_thread_.join();
+	}
+}
+
+//
+// Private functions
+//
+
+void OpenMetricsExporter::serveLoop(int socket)
+{
+	pollfd pfd{};
+	pfd.fd     = socket;
+	pfd.events = POLLIN;
+
+	while (running_) {
+		// Wake up regularly to notice `stop()`
+		if (0 >= ::poll(&pfd, 1, 100)) {
+			continue;
+		}
+
+		int client = ::accept(socket, nullptr, nullptr);
+		if (0 > client) {
+			continue;
+		}
+
+		timeval timeout{1, 0};
+		::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+		// Only the request line is of interest, the rest of the request is ignored
+		std::string request;
+		char        buf[1024];
+		while (std::string::npos == request.find("\r\n")) {
+			auto n = ::recv(client, buf, sizeof(buf), 0);
+			if (0 >= n) {
+				break;
+			}
+			request.append(buf, n);
+		}
+
+		std::string status = "200 OK";
+		std::string body;
+		if (0 == request.rfind("GET /metrics ", 0) || 0 == request.rfind("GET / ", 0)) {
+			body = timing_.openMetrics(prefix_);
+		} else {
+			status = "404 Not Found";
+		}
+
+		std::string response = "HTTP/1.1 " + status +
+		                       "\r\n"
+		                       "Content-Type: application/openmetrics-text; "
+		                       "version=1.0.0; charset=utf-8\r\n"
+		                       "Content-Length: " +
+		                       std::to_string(body.size()) +
+		                       "\r\n"
+		                       "Connection: close\r\n\r\n" +
+		                       body;
+
+		for (std::size_t sent{}; response.size() > sent;) {
+			auto n = ::send(client, response.data() + sent, response.size() - sent,
+			                MSG_NOSIGNAL);
+			if (0 >= n) {
+				break;
+			}
+			sent += n;
+		}
+
+		::close(client);
+	}
+
+	::close(socket);
+}
+}  // namespace ufo
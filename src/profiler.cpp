@@ -0,0 +1,458 @@
+// UFO
+#include <ufo/time/profiler.hpp>
+
+// STL
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+// POSIX
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <sys/syscall.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace ufo
+{
+namespace
+{
+// The running profiler, read by the signal handler
+std::atomic<Profiler*> active{nullptr};
+// Signal handlers currently running, so a stopped profiler is not destroyed under them
+std::atomic<int> in_handler{0};
+// The handler is never uninstalled, a signal still pending when a profiler stops would
+// otherwise terminate the process
+std::once_flag install;
+bool           installed = false;
+
+// The instruction the signal interrupted
+void* interruptedPc(void* context)
+{
+#if defined(__linux__) && defined(__x86_64__)
+	return reinterpret_cast<void*>(
+	    static_cast<ucontext_t*>(context)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__linux__) && defined(__aarch64__)
+	return reinterpret_cast<void*>(static_cast<ucontext_t*>(context)->uc_mcontext.pc);
+#else
+	static_cast<void>(context);
+	return nullptr;
+#endif
+}
+
+std::string functionName(void* address)
+{
+	Dl_info info;
+	if (0 == ::dladdr(address, &info)) {
+		std::stringstream ss;
+		ss << address;
+		return ss.str();
+	}
+
+	if (nullptr != info.dli_sname) {
+		int   status;
+		char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+		std::string name = 0 == status ? demangled : info.dli_sname;
+		std::free(demangled);
+		return name;
+	}
+
+	std::string module = nullptr == info.dli_fname ? "" : info.dli_fname;
+	module             = module.substr(module.find_last_of('/') + 1);
+
+	std::stringstream ss;
+	ss << module << "+0x" << std::hex
+	   << (static_cast<char*>(address) - static_cast<char*>(info.dli_fbase));
+	return ss.str();
+}
+}  // namespace
+
+//
+// Public functions
+//
+
+Profiler::Profiler(Timing const& timing, ProfilerOptions const& options)
+    : timing_(&timing)
+    , options_(options)
+    , slots_(std::make_unique<Slot[]>(options.capacity))
+{
+	options_.stack_depth = std::clamp(options_.stack_depth, 0, MAX_STACK_DEPTH);
+	// Not value-initialized, so the pages are only committed by the samples
+	stacks_.reset(new void*[options_.capacity * options_.stack_depth]);
+}
+
+Profiler::~Profiler() { stop(); }
+
+bool Profiler::start()
+{
+#ifdef __linux__
+	{
+		std::lock_guard lock(mutex_);
+		if (running_) {
+			return true;
+		}
+
+		std::call_once(install, [] {
+			// The first call loads the unwinder, which is not safe in the handler
+			void* stack[1];
+			::backtrace(stack, 1);
+
+			struct sigaction action {};
+			action.sa_sigaction = &Profiler::handler;
+			action.sa_flags     = SA_SIGINFO | SA_RESTART;
+			sigemptyset(&action.sa_mask);
+			installed = 0 == ::sigaction(SIGPROF, &action, nullptr);
+		});
+		if (!installed) {
+			return false;
+		}
+
+		Profiler* expected = nullptr;
+		if (!active.compare_exchange_strong(expected, this)) {
+			return false;
+		}
+
+		running_ = true;
+	}
+
+	if (!attach()) {
+		stop();
+		return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Profiler::stop()
+{
+	std::lock_guard lock(mutex_);
+	if (!running_) {
+		return;
+	}
+
+	stopTimers();
+	active = nullptr;
+	// Let handlers that already loaded the profiler finish
+	while (0 != in_handler.load()) {
+		std::this_thread::yield();
+	}
+	running_ = false;
+}
+
+bool Profiler::running() const
+{
+	std::lock_guard lock(mutex_);
+	return running_;
+}
+
+bool Profiler::attach()
+{
+#ifdef __linux__
+	std::lock_guard lock(mutex_);
+	if (!running_) {
+		return false;
+	}
+
+	auto id = std::this_thread::get_id();
+	if (0 < timers_.count(id)) {
+		return true;
+	}
+
+	// Accessing the thread's scope the first time may allocate, which the handler must not
+	[[maybe_unused]] Timing* volatile scope = Timing::scope_;
+
+	sigevent event{};
+	event.sigev_notify           = SIGEV_THREAD_ID;
+	event.sigev_signo            = SIGPROF;
+	event.sigev_notify_thread_id = static_cast<pid_t>(::syscall(SYS_gettid));
+
+	timer_t timer;
+	if (0 != ::timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer)) {
+		return false;
+	}
+
+	auto       ns = options_.interval.count();
+	itimerspec spec{};
+	spec.it_interval.tv_sec  = ns / 1'000'000'000;
+	spec.it_interval.tv_nsec = ns % 1'000'000'000;
+	spec.it_value            = spec.it_interval;
+	if (0 != ::timer_settime(timer, 0, &spec, nullptr)) {
+		::timer_delete(timer);
+		return false;
+	}
+
+	timers_.emplace(id, timer);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Profiler::detach()
+{
+	std::lock_guard lock(mutex_);
+	if (auto it = timers_.find(std::this_thread::get_id()); std::end(timers_) != it) {
+		::timer_delete(it->second);
+		timers_.erase(it);
+	}
+}
+
+ProfilerOptions const& Profiler::options() const { return options_; }
+
+std::size_t Profiler::numSamples() const
+{
+	return std::min(next_.load(std::memory_order_relaxed), options_.capacity);
+}
+
+std::size_t Profiler::numDropped() const
+{
+	auto next = next_.load(std::memory_order_relaxed);
+	return options_.capacity < next ? next - options_.capacity : 0;
+}
+
+std::vector<Profiler::Scope> Profiler::scopes() const
+{
+	struct Counts {
+		std::size_t                                                    samples = 0;
+		std::unordered_map<void*, std::pair<std::size_t, std::size_t>> functions;
+	};
+
+	// Aggregated by node first, the paths and names are only looked up once
+	std::unordered_map<Timing const*, Counts> nodes;
+	std::unordered_map<void*, void*>          symbols;
+	auto symbol = [&symbols](void* pc) {
+		auto [it, added] = symbols.try_emplace(pc, pc);
+		if (added) {
+			Dl_info info;
+			if (0 != ::dladdr(pc, &info) && nullptr != info.dli_saddr) {
+				it->second = info.dli_saddr;
+			}
+		}
+		return it->second;
+	};
+
+	for (std::size_t i{}, n = numSamples(); n != i; ++i) {
+		auto const& s = slots_[i];
+		if (!s.ready.load(std::memory_order_acquire)) {
+			continue;
+		}
+
+		auto& c     = nodes[s.scope];
+		auto  stack = &stacks_[i * options_.stack_depth];
+		++c.samples;
+		std::vector<void*> seen;
+		for (int d{}; s.depth != d; ++d) {
+			// Return addresses point after the call, which can be in the next function
+			auto pc = 0 == d ? stack[d] : static_cast<char*>(stack[d]) - 1;
+			auto f  = symbol(pc);
+			if (0 == d) {
+				++c.functions[f].first;
+			}
+			if (std::end(seen) == std::find(std::begin(seen), std::end(seen), f)) {
+				seen.push_back(f);
+				++c.functions[f].second;
+			}
+		}
+	}
+
+	// The scope of a thread can be left over from a destroyed tree, so the pointers are
+	// only compared against the nodes of the profiled tree and never dereferenced
+	std::unordered_map<Timing const*, std::vector<std::string>> paths;
+	pathsRecurs(*timing_, {}, paths);
+
+	std::map<std::vector<std::string>, Scope> sorted;
+	for (auto& [node, counts] : nodes) {
+		auto                     p = paths.find(node);
+		std::vector<std::string> path;
+		if (std::end(paths) != p) {
+			path = p->second;
+		}
+
+		auto& scope = sorted[path];
+		scope.path  = path;
+		scope.samples += counts.samples;
+		for (auto const& [f, c] : counts.functions) {
+			auto name = functionName(f);
+			auto it   = std::find_if(std::begin(scope.functions), std::end(scope.functions),
+			                         [&name](Function const& e) { return e.name == name; });
+			if (std::end(scope.functions) == it) {
+				scope.functions.push_back({name, c.first, c.second});
+			} else {
+				it->self += c.first;
+				it->total += c.second;
+			}
+		}
+
+		// The parents are added so the scopes form a tree
+		for (std::size_t i = 1; path.size() > i; ++i) {
+			std::vector<std::string> parent(std::begin(path), std::begin(path) + i);
+			sorted[parent].path = parent;
+		}
+	}
+
+	std::vector<Scope> ret;
+	for (auto& [path, scope] : sorted) {
+		std::sort(std::begin(scope.functions), std::end(scope.functions),
+		          [](Function const& a, Function const& b) {
+			          return a.self != b.self ? a.self > b.self : a.total > b.total;
+		          });
+		scope.total = scope.samples;
+		ret.push_back(std::move(scope));
+	}
+
+	// Depth-first order, so the children of a scope directly follow it
+	for (std::size_t i = ret.size(); 0 != i--;) {
+		if (ret[i].path.empty()) {
+			continue;
+		}
+		for (std::size_t j = i + 1; ret.size() > j && ret[j].path.size() > ret[i].path.size();
+		     ++j) {
+			if (ret[j].path.size() == ret[i].path.size() + 1) {
+				ret[i].total += ret[j].total;
+			}
+		}
+	}
+
+	return ret;
+}
+
+void Profiler::clear()
+{
+	std::lock_guard lock(mutex_);
+	if (running_) {
+		return;
+	}
+
+	for (std::size_t i{}, n = numSamples(); n != i; ++i) {
+		slots_[i].ready = false;
+	}
+	next_ = 0;
+}
+
+void Profiler::print(std::string const& name, std::size_t functions) const
+{
+	auto data = scopes();
+
+	std::size_t all{};
+	for (auto const& s : data) {
+		all += s.samples;
+	}
+
+	std::vector<std::pair<int, std::string>> tags;
+	std::vector<std::string>                 colors;
+	std::vector<std::vector<std::wstring>>   columns{
+	      {L" Samples "}, {L" Self % "}, {L" Total % "}};
+
+	auto percent = [](std::size_t part, std::size_t whole) {
+		std::wstringstream ss;
+		ss << std::fixed << std::setprecision(1) << L' '
+		   << (0 == whole ? 0.0 : 100.0 * part / whole) << L' ';
+		return ss.str();
+	};
+
+	for (auto const& s : data) {
+		int level = s.path.empty() ? 0 : static_cast<int>(s.path.size()) - 1;
+		tags.emplace_back(level, s.path.empty() ? "(outside)" : s.path.back());
+		colors.push_back("");
+		columns[0].push_back(L" " + std::to_wstring(s.samples) + L" ");
+		columns[1].push_back(percent(s.samples, all));
+		columns[2].push_back(percent(s.total, all));
+
+		for (std::size_t i{}; std::min(functions, s.functions.size()) != i; ++i) {
+			auto const& f = s.functions[i];
+			// Long (template) names are cut to keep the table readable
+			tags.emplace_back(level + 1,
+			                  60 < f.name.size() ? f.name.substr(0, 57) + "..." : f.name);
+			colors.push_back(Timing::cyanColor());
+			columns[0].push_back(L" " + std::to_wstring(f.self) + L" ");
+			columns[1].push_back(percent(f.self, s.samples));
+			columns[2].push_back(percent(f.total, s.samples));
+		}
+	}
+
+	std::vector<std::pair<std::wstring, std::wstring>> component{
+	    {L" Scope / function ", L""}};
+	Timing::addTags(component, tags);
+
+	Timing::printTable(Timing::header(name.empty() ? "Profile" : name, L"samples"),
+	                   component, colors, columns, false);
+}
+
+//
+// Private functions
+//
+
+void Profiler::handler(int /* signal */, siginfo_t* /* info */, void* context)
+{
+	auto saved = errno;
+	++in_handler;
+	if (Profiler* p = active.load(); nullptr != p) {
+		p->sample(context);
+	}
+	--in_handler;
+	errno = saved;
+}
+
+void Profiler::sample(void* context)
+{
+	auto i = next_.fetch_add(1, std::memory_order_relaxed);
+	if (options_.capacity <= i) {
+		return;
+	}
+
+	auto& s = slots_[i];
+	s.scope = Timing::scope_;
+	s.depth = 0;
+
+	if (0 < options_.stack_depth) {
+		// The first frames are the handler and the signal trampoline
+		void* stack[MAX_STACK_DEPTH + 4];
+		int   n     = ::backtrace(stack, options_.stack_depth + 4);
+		int   first = std::min(n, 2);
+		if (void* pc = interruptedPc(context); nullptr != pc) {
+			for (int j{}; n != j; ++j) {
+				if (pc == stack[j]) {
+					first = j;
+					break;
+				}
+			}
+		}
+		s.depth = std::min(n - first, options_.stack_depth);
+		std::copy(stack + first, stack + first + s.depth,
+		          &stacks_[i * options_.stack_depth]);
+	}
+
+	s.ready.store(true, std::memory_order_release);
+}
+
+void Profiler::pathsRecurs(
+    Timing const& timing, std::vector<std::string> path,
+    std::unordered_map<Timing const*, std::vector<std::string>>& paths) const
+{
+	path.push_back(timing.tag_);
+
+	std::lock_guard lock(timing.mutex_);
+	for (auto const& [_, child] : timing.children_) {
+		pathsRecurs(child, path, paths);
+	}
+	paths.emplace(&timing, std::move(path));
+}
+
+void Profiler::stopTimers()
+{
+	for (auto const& [_, timer] : timers_) {
+		::timer_delete(timer);
+	}
+	timers_.clear();
+}
+}  // namespace ufo
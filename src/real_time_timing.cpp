@@ -0,0 +1,228 @@
+// UFO
+#include <ufo/time/real_time_timing.hpp>
+
+// STL
+#include <algorithm>
+
+namespace ufo
+{
+namespace
+{
+std::atomic<std::uint64_t> next_id{1};
+
+// The state of the calling thread in the last `RealTimeTiming` it used, so finding it
+// does not search
+thread_local std::uint64_t cached_id     = 0;
+thread_local void*         cached_thread = nullptr;
+}  // namespace
+
+//
+// Public functions
+//
+
+RealTimeTiming::RealTimeTiming(Timing& timing, std::size_t max_threads,
+                               std::size_t max_depth)
+    : max_depth_(max_depth)
+    , id_(next_id++)
+    , threads_(std::make_unique<Thread[]>(max_threads))
+    , max_threads_(max_threads)
+{
+	nodes_.push_back({timing.tag(), 0, {}, 0, &timing});
+	addRecurs(timing, 0);
+}
+
+bool RealTimeTiming::attach()
+{
+	std::lock_guard lock(mutex_);
+	if (nullptr != thread()) {
+		return true;
+	}
+
+	auto n = num_threads_.load(std::memory_order_relaxed);
+	if (max_threads_ == n) {
+		return false;
+	}
+
+	auto& t   = threads_[n];
+	t.id      = std::this_thread::get_id();
+	t.timers  = std::make_unique<Timer[]>(nodes_.size());
+	t.flushed = std::make_unique<Timer[]>(nodes_.size());
+	t.stack   = std::make_unique<Running[]>(max_depth_);
+	num_threads_.store(n + 1, std::memory_order_release);
+
+	cached_id     = id_;
+	cached_thread = &t;
+	return true;
+}
+
+bool RealTimeTiming::start(std::string_view tag)
+{
+	auto now = std::chrono::high_resolution_clock::now();
+
+	Thread* t = thread();
+	if (nullptr == t) {
+		return false;
+	}
+
+	if (max_depth_ <= t->depth) {
+		++t->depth;
+		t->overflows.store(t->overflows.load(std::memory_order_relaxed) + 1,
+		                   std::memory_order_relaxed);
+		return true;
+	}
+
+	auto const& parent   = nodes_[0 == t->depth ? 0 : t->stack[t->depth - 1].node];
+	auto const& children = parent.children;
+	auto it = std::lower_bound(std::begin(children), std::end(children), tag,
+	                           [](auto const& child, std::string_view tag) {
+		                           return child.first < tag;
+	                           });
+
+	std::size_t node;
+	if (std::end(children) != it && it->first == tag) {
+		node = it->second;
+	} else {
+		node = parent.other;
+		t->overflows.store(t->overflows.load(std::memory_order_relaxed) + 1,
+		                   std::memory_order_relaxed);
+	}
+
+	t->stack[t->depth++] = {node, now};
+	return true;
+}
+
+bool RealTimeTiming::stop()
+{
+	auto now = std::chrono::high_resolution_clock::now();
+
+	Thread* t = thread();
+	if (nullptr == t || 0 == t->depth) {
+		return false;
+	}
+
+	if (max_depth_ < t->depth) {
+		--t->depth;
+		return true;
+	}
+
+	auto const& r = t->stack[--t->depth];
+
+	// Readers retry if the sequence changed while they copied the timers
+	auto sequence = t->sequence.load(std::memory_order_relaxed);
+	t->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	t->timers[r.node].addSample(r.start, now);
+	t->sequence.store(sequence + 2, std::memory_order_release);
+
+	return true;
+}
+
+void RealTimeTiming::flush()
+{
+	std::lock_guard lock(mutex_);
+
+	std::vector<Timer> timers(nodes_.size());
+	for (std::size_t i{}, n = num_threads_.load(std::memory_order_acquire); n != i; ++i) {
+		auto& t = threads_[i];
+
+		for (;;) {
+			auto sequence = t.sequence.load(std::memory_order_acquire);
+			if (1 == sequence % 2) {
+				std::this_thread::yield();
+				continue;
+			}
+			std::copy(t.timers.get(), t.timers.get() + nodes_.size(), std::begin(timers));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (t.sequence.load(std::memory_order_relaxed) == sequence) {
+				break;
+			}
+		}
+
+		for (std::size_t j{}; nodes_.size() != j; ++j) {
+			if (timers[j].numSamples() == t.flushed[j].numSamples()) {
+				continue;
+			}
+
+			Timer delta = timers[j];
+			delta -= t.flushed[j];
+			t.flushed[j] = timers[j];
+
+			auto&           timing = target(j);
+			std::lock_guard timing_lock(timing.mutex_);
+			timing.timer_ += delta;
+		}
+	}
+}
+
+std::size_t RealTimeTiming::numNodes() const { return nodes_.size(); }
+
+std::size_t RealTimeTiming::numThreads() const
+{
+	return num_threads_.load(std::memory_order_acquire);
+}
+
+std::size_t RealTimeTiming::numOverflows() const
+{
+	std::size_t overflows{};
+	for (std::size_t i{}, n = numThreads(); n != i; ++i) {
+		overflows += threads_[i].overflows.load(std::memory_order_relaxed);
+	}
+	return overflows;
+}
+
+//
+// Private functions
+//
+
+void RealTimeTiming::addRecurs(Timing& timing, std::size_t parent)
+{
+	std::lock_guard lock(timing.mutex_);
+
+	// The children map is sorted by tag, so are the children of the node
+	bool has_other = false;
+	for (auto& [tag, child] : timing.children_) {
+		auto i = nodes_.size();
+		nodes_.push_back({tag, parent, {}, i, &child});
+		nodes_[parent].children.emplace_back(tag, i);
+		if (Timing::otherTag() == tag) {
+			nodes_[parent].other = i;
+			has_other            = true;
+		}
+		addRecurs(child, i);
+	}
+
+	if (!has_other) {
+		auto i = nodes_.size();
+		nodes_.push_back({Timing::otherTag(), parent, {}, i, nullptr});
+		nodes_[parent].other = i;
+	}
+}
+
+RealTimeTiming::Thread* RealTimeTiming::thread() const
+{
+	if (id_ == cached_id) {
+		return static_cast<Thread*>(cached_thread);
+	}
+
+	auto id = std::this_thread::get_id();
+	for (std::size_t i{}, n = numThreads(); n != i; ++i) {
+		if (id == threads_[i].id) {
+			cached_id     = id_;
+			cached_thread = &threads_[i];
+			return &threads_[i];
+		}
+	}
+	return nullptr;
+}
+
+Timing& RealTimeTiming::target(std::size_t node)
+{
+	auto& n = nodes_[node];
+	if (nullptr == n.target) {
+		auto&           parent = target(n.parent);
+		std::lock_guard lock(parent.mutex_);
+		n.target = &parent.child(Timing::otherTag());
+	}
+	return *n.target;
+}
+}  // namespace ufo
@@ -0,0 +1,396 @@
+// UFO
+#include <ufo/time/shared_memory.hpp>
+
+// STL
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+// POSIX
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ufo
+{
+namespace
+{
+constexpr char          MAGIC[8] = {'U', 'F', 'O', 'S', 'H', 'M', '1', '\0'};
+constexpr std::uint32_t VERSION  = 1;
+
+constexpr std::size_t TAG_SIZE = 64;
+
+// POSIX shared memory names start with a slash
+std::string segment(std::string const& name)
+{
+	return '/' == name.front() ? name : '/' + name;
+}
+
+template <class Rep, class Period>
+std::int64_t nanoseconds(std::chrono::duration<Rep, Period> d)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+}  // namespace
+
+struct SharedMemoryPublisher::Header {
+	char                       magic[8];
+	std::uint32_t              version;
+	std::uint32_t              capacity;
+	std::atomic<std::uint64_t> sequence;
+	std::uint32_t              num_nodes;
+	std::uint32_t              truncated;
+	std::int64_t               pid;
+	// Wall clock time of the last snapshot
+	std::int64_t updated;
+};
+
+struct SharedMemoryPublisher::Node {
+	std::uint32_t parent;  // Zero for the root, else index + 1
+	std::uint32_t running_threads;
+	std::uint32_t max_concurrent_threads;
+	std::uint32_t reserved;
+	std::uint64_t samples;
+	std::uint64_t deadline_misses;
+	std::int64_t  total;
+	std::int64_t  last;
+	std::int64_t  min;
+	std::int64_t  max;
+	double        mean;
+	// Sum of squared differences from the mean, in seconds squared
+	double sum_squares_diffs;
+	char   tag[TAG_SIZE];
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "The sequence number has to be lock free to be shared between processes");
+
+//
+// Public functions
+//
+
+SharedMemoryPublisher::SharedMemoryPublisher(Timing const& timing, std::string const& name,
+                                             std::size_t capacity)
+    : timing_(timing), name_(segment(name)), capacity_(capacity)
+{
+	size_ = sizeof(Header) + capacity_ * sizeof(Node);
+
+	// Never truncates a segment another publisher is using
+	fd_ = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+	if (0 > fd_ && EEXIST == errno) {
+		// Left behind by a publisher that did not exit cleanly
+		if (SharedMemoryReader stale(name_); stale.isOpen() && !stale.alive()) {
+			::shm_unlink(name_.c_str());
+			fd_ = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+		}
+	}
+	if (0 > fd_) {
+		return;
+	}
+
+	if (0 != ::ftruncate(fd_, static_cast<off_t>(size_))) {
+		::close(fd_);
+		::shm_unlink(name_.c_str());
+		fd_ = -1;
+		return;
+	}
+
+	data_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+	if (MAP_FAILED == data_) {
+		::close(fd_);
+		::shm_unlink(name_.c_str());
+		data_ = nullptr;
+		fd_   = -1;
+		return;
+	}
+
+	auto h = new (data_) Header{};
+	std::memcpy(h->magic, MAGIC, sizeof(MAGIC));
+	h->version  = VERSION;
+	h->capacity = static_cast<std::uint32_t>(capacity_);
+	h->pid      = ::getpid();
+}
+
+SharedMemoryPublisher::~SharedMemoryPublisher()
+{
+	stop();
+
+	if (nullptr != data_) {
+		::munmap(data_, size_);
+	}
+
+	if (0 <= fd_) {
+		::close(fd_);
+		::shm_unlink(name_.c_str());
+	}
+}
+
+bool SharedMemoryPublisher::isOpen() const { return 0 <= fd_; }
+
+std::string const& SharedMemoryPublisher::name() const { return name_; }
+
+bool SharedMemoryPublisher::publish()
+{
+	if (!isOpen()) {
+		return false;
+	}
+
+	std::lock_guard lock(publish_mutex_);
+
+	// Collected before the sequence number is odd, so readers only wait for the copy
+	std::vector<Node> nodes;
+	nodes.reserve(capacity_);
+	bool truncated{};
+	collect(timing_, 0, nodes, truncated);
+
+	auto h        = static_cast<Header*>(data_);
+	auto sequence = h->sequence.load(std::memory_order_relaxed);
+	h->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	std::memcpy(static_cast<unsigned char*>(data_) + sizeof(Header), nodes.data(),
+	            nodes.size() * sizeof(Node));
+	h->num_nodes = static_cast<std::uint32_t>(nodes.size());
+	h->truncated = truncated;
+	h->updated   = nanoseconds(std::chrono::system_clock::now().time_since_epoch());
+
+	h->sequence.store(sequence + 2, std::memory_order_release);
+
+	return true;
+}
+
+void SharedMemoryPublisher::publishPeriodically(std::chrono::milliseconds interval)
+{
+	if (thread_.joinable()) {
+		return;
+	}
+
+	running_ = true;
+	thread_  = std::thread([this, interval]() {
+		std::unique_lock lock(mutex_);
+		while (running_) {
+			lock.unlock();
+			publish();
+			lock.lock();
+			cv_.wait_for(lock, interval, [this]() { return !running_; });
+		}
+	});
+}
+
+void SharedMemoryPublisher::stop()
+{
+	{
+		std::lock_guard lock(mutex_);
+		running_ = false;
+	}
+	cv_.notify_all();
+
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+}
+
+SharedMemoryReader::SharedMemoryReader(std::string const& name)
+{
+	fd_ = ::shm_open(segment(name).c_str(), O_RDONLY, 0);
+	if (0 > fd_) {
+		return;
+	}
+
+	using Header = SharedMemoryPublisher::Header;
+	using Node   = SharedMemoryPublisher::Node;
+
+	struct stat st;
+	if (0 != ::fstat(fd_, &st) || sizeof(Header) > static_cast<std::size_t>(st.st_size)) {
+		::close(fd_);
+		fd_ = -1;
+		return;
+	}
+
+	size_   = static_cast<std::size_t>(st.st_size);
+	void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+	if (MAP_FAILED == p) {
+		::close(fd_);
+		fd_ = -1;
+		return;
+	}
+	data_ = static_cast<unsigned char const*>(p);
+
+	auto h    = reinterpret_cast<Header const*>(data_);
+	capacity_ = h->capacity;
+	if (0 != std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) || VERSION != h->version ||
+	    sizeof(Header) + capacity_ * sizeof(Node) > size_) {
+		::munmap(const_cast<unsigned char*>(data_), size_);
+		::close(fd_);
+		data_ = nullptr;
+		fd_   = -1;
+	}
+}
+
+SharedMemoryReader::~SharedMemoryReader()
+{
+	if (nullptr != data_) {
+		::munmap(const_cast<unsigned char*>(data_), size_);
+	}
+
+	if (0 <= fd_) {
+		::close(fd_);
+	}
+}
+
+std::vector<std::string> SharedMemoryReader::publishers(std::string const& prefix)
+{
+	// Where Linux keeps the POSIX shared memory segments
+	std::vector<std::string> res;
+	std::error_code          ec;
+	for (auto const& entry : std::filesystem::directory_iterator("/dev/shm", ec)) {
+		auto name = entry.path().filename().string();
+		if (0 == name.compare(0, prefix.size(), prefix)) {
+			res.push_back(name);
+		}
+	}
+	std::sort(std::begin(res), std::end(res));
+	return res;
+}
+
+bool SharedMemoryReader::isOpen() const { return 0 <= fd_; }
+
+std::int64_t SharedMemoryReader::pid() const
+{
+	return isOpen()
+	           ? reinterpret_cast<SharedMemoryPublisher::Header const*>(data_)->pid
+	           : 0;
+}
+
+bool SharedMemoryReader::alive() const
+{
+	auto p = pid();
+	// The process exists if it can be signaled, or exists but belongs to another user
+	return 0 < p && (0 == ::kill(static_cast<pid_t>(p), 0) || EPERM == errno);
+}
+
+std::uint64_t SharedMemoryReader::numPublished() const
+{
+	return isOpen() ? reinterpret_cast<SharedMemoryPublisher::Header const*>(data_)
+	                          ->sequence.load(std::memory_order_acquire) /
+	                      2
+	                : 0;
+}
+
+bool SharedMemoryReader::read(Timing& timing) const
+{
+	using Header   = SharedMemoryPublisher::Header;
+	using Node     = SharedMemoryPublisher::Node;
+	using Duration = std::chrono::high_resolution_clock::duration;
+
+	if (!isOpen()) {
+		return false;
+	}
+
+	auto h = reinterpret_cast<Header const*>(data_);
+
+	std::vector<Node> nodes;
+	bool              consistent{};
+	for (int attempt{}; 1000 > attempt && !consistent; ++attempt) {
+		auto sequence = h->sequence.load(std::memory_order_acquire);
+		if (1 == (sequence & 1)) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		nodes.resize(std::min<std::size_t>(h->num_nodes, capacity_));
+		std::memcpy(nodes.data(), data_ + sizeof(Header), nodes.size() * sizeof(Node));
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		consistent = h->sequence.load(std::memory_order_relaxed) == sequence;
+	}
+
+	if (!consistent) {
+		return false;
+	}
+
+	std::vector<Timing*> timings(nodes.size(), nullptr);
+	for (std::size_t i{}; nodes.size() > i; ++i) {
+		auto const& n = nodes[i];
+
+		if (0 == n.parent) {
+			timings[i] = &timing;
+		} else if (i >= n.parent && nullptr != timings[n.parent - 1]) {
+			timings[i] =
+			    &(*timings[n.parent - 1])[std::string(n.tag, strnlen(n.tag, TAG_SIZE))];
+		} else {
+			continue;
+		}
+
+		Timer t;
+		if (0 < n.samples) {
+			t.samples_           = static_cast<int>(n.samples);
+			t.total_             = std::chrono::nanoseconds(n.total);
+			t.last_              = std::chrono::nanoseconds(n.last);
+			t.mean_              = std::chrono::duration<double, std::nano>(n.mean);
+			t.sum_squares_diffs_ = n.sum_squares_diffs;
+			t.min_ = std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(n.min));
+			t.max_ = std::chrono::duration_cast<Duration>(std::chrono::nanoseconds(n.max));
+		}
+
+		auto&           node = *timings[i];
+		std::lock_guard lock(node.mutex_);
+		node.timer_ += t;
+		node.max_concurrent_threads_ =
+		    std::max<std::size_t>(node.max_concurrent_threads_, n.max_concurrent_threads);
+		node.deadline_misses_ += n.deadline_misses;
+	}
+
+	return true;
+}
+
+//
+// Private functions
+//
+
+void SharedMemoryPublisher::collect(Timing const& node, std::uint32_t parent,
+                                    std::vector<Node>& nodes, bool& truncated) const
+{
+	if (capacity_ == nodes.size()) {
+		truncated = true;
+		return;
+	}
+
+	// Only this node is locked while it is copied, so timing is not blocked for the
+	// whole traversal
+	std::vector<Timing const*> children;
+	{
+		std::lock_guard lock(node.mutex_);
+
+		auto& n                  = nodes.emplace_back();
+		n.parent                 = parent;
+		n.running_threads        = static_cast<std::uint32_t>(node.numRunningThreads());
+		n.max_concurrent_threads = static_cast<std::uint32_t>(node.max_concurrent_threads_);
+		n.reserved               = 0;
+		n.samples                = static_cast<std::uint64_t>(node.timer_.samples_);
+		n.deadline_misses        = node.deadline_misses_;
+		n.total                  = nanoseconds(node.timer_.total_);
+		n.last                   = nanoseconds(node.timer_.last_);
+		n.min                    = 0 < n.samples ? nanoseconds(node.timer_.min_) : 0;
+		n.max                    = 0 < n.samples ? nanoseconds(node.timer_.max_) : 0;
+		n.mean = std::chrono::duration<double, std::nano>(node.timer_.mean_).count();
+		n.sum_squares_diffs = node.timer_.sum_squares_diffs_;
+		std::memset(n.tag, 0, TAG_SIZE);
+		node.tag_.copy(n.tag, TAG_SIZE);
+
+		children.reserve(node.children_.size());
+		for (auto const& [_, child] : node.children_) {
+			children.push_back(&child);
+		}
+	}
+
+	// `n` is invalidated when the children are added
+	auto index = static_cast<std::uint32_t>(nodes.size());
+	for (auto child : children) {
+		collect(*child, index, nodes, truncated);
+	}
+}
+}  // namespace ufo
@@ -0,0 +1,239 @@
+// UFO
+#include <ufo/time/statistics.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace ufo
+{
+double incompleteBeta(double a, double b, double x)
+{
+	if (0.0 >= x) {
+		return 0.0;
+	} else if (1.0 <= x) {
+		return 1.0;
+	}
+
+	// The continued fraction converges rapidly for x < (a + 1) / (a + b + 2), use the
+	// symmetry relation otherwise
+	if ((a + 1.0) / (a + b + 2.0) < x) {
+		return 1.0 - incompleteBeta(b, a, 1.0 - x);
+	}
+
+	double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+	                        a * std::log(x) + b * std::log1p(-x)) /
+	               a;
+
+	// Modified Lentz's method
+	constexpr double tiny = 1e-300;
+	constexpr double eps  = 1e-15;
+
+	double f = 1.0;
+	double c = 1.0;
+	double d = 0.0;
+	for (int i{}; 500 > i; ++i) {
+		int    m = i / 2;
+		double numerator;
+		if (0 == i) {
+			numerator = 1.0;
+		} else if (0 == i % 2) {
+			numerator = (m * (b - m) * x) / ((a + 2.0 * m - 1.0) * (a + 2.0 * m));
+		} else {
+			numerator = -((a + m) * (a + b + m) * x) / ((a + 2.0 * m) * (a + 2.0 * m + 1.0));
+		}
+
+		d = 1.0 + numerator * d;
+		d = tiny > std::abs(d) ? tiny : d;
+		d = 1.0 / d;
+		c = 1.0 + numerator / c;
+		c = tiny > std::abs(c) ? tiny : c;
+
+		double cd = c * d;
+		f *= cd;
+
+		if (eps > std::abs(1.0 - cd)) {
+			break;
+		}
+	}
+
+	return front * (f - 1.0);
+}
+
+double studentTCdf(double t, double df)
+{
+	if (std::isinf(t)) {
+		return 0.0 < t ? 1.0 : 0.0;
+	}
+
+	double tail = 0.5 * incompleteBeta(0.5 * df, 0.5, df / (df + t * t));
+	return 0.0 < t ? 1.0 - tail : tail;
+}
+
+double studentTQuantile(double p, double df)
+{
+	if (0.0 >= p) {
+		return -std::numeric_limits<double>::infinity();
+	} else if (1.0 <= p) {
+		return std::numeric_limits<double>::infinity();
+	}
+
+	// Bisection, the CDF is monotonic
+	double lo = -1.0;
+	double hi = 1.0;
+	while (studentTCdf(lo, df) > p) {
+		lo *= 2.0;
+	}
+	while (studentTCdf(hi, df) < p) {
+		hi *= 2.0;
+	}
+	for (int i{}; 200 > i && 1e-12 < hi - lo; ++i) {
+		double mid = 0.5 * (lo + hi);
+		(studentTCdf(mid, df) < p ? lo : hi) = mid;
+	}
+	return 0.5 * (lo + hi);
+}
+
+WelchTTest welchTTest(double mean_1, double sample_variance_1, double n_1, double mean_2,
+                      double sample_variance_2, double n_2)
+{
+	constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+	if (2.0 > n_1 || 2.0 > n_2) {
+		return {nan, nan, nan};
+	}
+
+	double se_1 = sample_variance_1 / n_1;
+	double se_2 = sample_variance_2 / n_2;
+	double se   = se_1 + se_2;
+
+	if (0.0 >= se) {
+		// No variance, any difference is significant
+		if (mean_1 == mean_2) {
+			return {0.0, n_1 + n_2 - 2.0, 1.0};
+		}
+		return {std::copysign(std::numeric_limits<double>::infinity(), mean_2 - mean_1),
+		        n_1 + n_2 - 2.0, 0.0};
+	}
+
+	double t  = (mean_2 - mean_1) / std::sqrt(se);
+	double df = se * se / (se_1 * se_1 / (n_1 - 1.0) + se_2 * se_2 / (n_2 - 1.0));
+	double p  = incompleteBeta(0.5 * df, 0.5, df / (df + t * t));
+
+	return {t, df, p};
+}
+
+WelchTTest welchTTest(Timer const& first, Timer const& second)
+{
+	return welchTTest(first.meanSeconds(), first.sampleVarianceSeconds(),
+	                  first.numSamples(), second.meanSeconds(),
+	                  second.sampleVarianceSeconds(), second.numSamples());
+}
+
+char const* complexityName(Complexity complexity)
+{
+	switch (complexity) {
+		case Complexity::CONSTANT: return "O(1)";
+		case Complexity::LOGARITHMIC: return "O(log n)";
+		case Complexity::LINEAR: return "O(n)";
+		case Complexity::LINEARITHMIC: return "O(n log n)";
+		case Complexity::QUADRATIC: return "O(n^2)";
+		case Complexity::CUBIC: return "O(n^3)";
+	}
+	return "";
+}
+
+ComplexityFit fitComplexity(std::vector<double> const& sizes,
+                            std::vector<double> const& seconds,
+                            std::vector<double> const& weights)
+{
+	constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+	std::vector<std::array<double, 3>> points;  // Size, seconds and weight
+	for (std::size_t i{}; sizes.size() > i && seconds.size() > i; ++i) {
+		double w = weights.size() > i ? weights[i] : 1.0;
+		if (0.0 < sizes[i] && 0.0 < seconds[i] && 0.0 < w) {
+			points.push_back({sizes[i], seconds[i], w});
+		}
+	}
+
+	double min_size = std::numeric_limits<double>::infinity();
+	double max_size = 0.0;
+	for (auto const& [n, t, w] : points) {
+		min_size = std::min(min_size, n);
+		max_size = std::max(max_size, n);
+	}
+	if (!(min_size < max_size)) {
+		return {nan, Complexity::CONSTANT, nan, nan};
+	}
+
+	ComplexityFit fit{};
+
+	// Weighted least squares of log t = log a + b log n
+	double sw{}, sx{}, sy{};
+	for (auto const& [n, t, w] : points) {
+		sw += w;
+		sx += w * std::log(n);
+		sy += w * std::log(t);
+	}
+	double mx = sx / sw;
+	double my = sy / sw;
+	double sxx{}, sxy{};
+	for (auto const& [n, t, w] : points) {
+		sxx += w * (std::log(n) - mx) * (std::log(n) - mx);
+		sxy += w * (std::log(n) - mx) * (std::log(t) - my);
+	}
+	fit.exponent = sxy / sxx;
+
+	// Least squares of t = c f(n) for each class, the one with the smallest residual wins
+	auto f = [](Complexity complexity, double n) {
+		switch (complexity) {
+			case Complexity::CONSTANT: return 1.0;
+			case Complexity::LOGARITHMIC: return std::log2(n);
+			case Complexity::LINEAR: return n;
+			case Complexity::LINEARITHMIC: return n * std::log2(n);
+			case Complexity::QUADRATIC: return n * n;
+			case Complexity::CUBIC: return n * n * n;
+		}
+		return 0.0;
+	};
+
+	double mean{};
+	for (auto const& [n, t, w] : points) {
+		mean += w * t;
+	}
+	mean /= sw;
+
+	fit.error = std::numeric_limits<double>::infinity();
+	for (auto complexity :
+	     {Complexity::CONSTANT, Complexity::LOGARITHMIC, Complexity::LINEAR,
+	      Complexity::LINEARITHMIC, Complexity::QUADRATIC, Complexity::CUBIC}) {
+		double sff{}, stf{};
+		for (auto const& [n, t, w] : points) {
+			sff += w * f(complexity, n) * f(complexity, n);
+			stf += w * t * f(complexity, n);
+		}
+		if (0.0 >= sff) {
+			continue;
+		}
+
+		double c = stf / sff;
+		double ss{};
+		for (auto const& [n, t, w] : points) {
+			ss += w * (t - c * f(complexity, n)) * (t - c * f(complexity, n));
+		}
+
+		double error = std::sqrt(ss / sw) / mean;
+		if (error < fit.error) {
+			fit.complexity  = complexity;
+			fit.coefficient = c;
+			fit.error       = error;
+		}
+	}
+
+	return fit;
+}
+}  // namespace ufo
@@ -0,0 +1,160 @@
+// UFO
+#include <ufo/time/time_series.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ufo
+{
+//
+// Public functions
+//
+
+std::vector<TimeSeries::Resolution> TimeSeries::defaultResolutions()
+{
+	using namespace std::chrono_literals;
+	return {{1s, 300}, {1min, 240}};
+}
+
+TimeSeries::TimeSeries(std::vector<Resolution> const& resolutions)
+{
+	for (auto const& r : resolutions) {
+		if (0 < r.num && decltype(r.interval)::zero() < r.interval) {
+			rings_.push_back({r, std::vector<Slot>(r.num)});
+		}
+	}
+}
+
+void TimeSeries::add(std::chrono::time_point<std::chrono::high_resolution_clock> start,
+                     std::chrono::time_point<std::chrono::high_resolution_clock> stop)
+{
+	for (auto& r : rings_) {
+		std::int64_t index = stop.time_since_epoch() / r.resolution.interval;
+		if (index <= r.latest - static_cast<std::int64_t>(r.slots.size())) {
+			// Older than the ring
+			continue;
+		}
+
+		auto& s = r.slots[index % r.slots.size()];
+		if (s.index != index) {
+			// The interval that was here is older than the ring
+			s.index = index;
+			s.timer.reset();
+			s.histogram.reset();
+		}
+		s.timer.addSample(start, stop);
+		s.histogram.add(stop - start);
+		r.latest = std::max(r.latest, index);
+	}
+}
+
+void TimeSeries::reset()
+{
+	for (auto& r : rings_) {
+		std::fill(std::begin(r.slots), std::end(r.slots), Slot{});
+		r.latest = -1;
+	}
+}
+
+std::size_t TimeSeries::numResolutions() const { return rings_.size(); }
+
+TimeSeries::Resolution TimeSeries::resolution(std::size_t index) const
+{
+	return rings_.at(index).resolution;
+}
+
+std::vector<TimeSeries::Interval> TimeSeries::intervals(std::size_t index) const
+{
+	auto const& r = rings_.at(index);
+	if (0 > r.latest) {
+		return {};
+	}
+
+	auto         num   = static_cast<std::int64_t>(r.slots.size());
+	std::int64_t first = r.latest;
+	for (auto const& s : r.slots) {
+		if (0 <= s.index && r.latest - num < s.index) {
+			first = std::min(first, s.index);
+		}
+	}
+
+	// Once for all intervals, so they are equally spaced in wall clock time as well
+	auto now      = std::chrono::high_resolution_clock::now();
+	auto wall_now = std::chrono::system_clock::now();
+
+	std::vector<Interval> res;
+	for (auto i = first; r.latest >= i; ++i) {
+		auto age = now - std::chrono::time_point<std::chrono::high_resolution_clock>(
+		                     i * r.resolution.interval);
+
+		auto& interval = res.emplace_back();
+		interval.start =
+		    wall_now - std::chrono::duration_cast<std::chrono::system_clock::duration>(age);
+		if (auto const& s = r.slots[i % num]; i == s.index) {
+			interval.timer     = s.timer;
+			interval.histogram = s.histogram;
+		}
+	}
+	return res;
+}
+
+void TimeSeries::writeJson(std::ostream& out) const
+{
+	auto number = [&out](double value) -> std::ostream& {
+		return std::isfinite(value) ? out << value : out << "null";
+	};
+
+	auto flags = out.flags();
+	auto prec  = out.precision(std::numeric_limits<double>::digits10);
+
+	out << "{\n  \"resolutions\": [";
+	for (std::size_t i{}; rings_.size() > i; ++i) {
+		out << (0 == i ? "\n" : ",\n") << "    {\"interval\": ";
+		number(std::chrono::duration<double>(rings_[i].resolution.interval).count())
+		    << ", \"intervals\": [";
+
+		bool first = true;
+		for (auto const& interval : intervals(i)) {
+			auto const& t = interval.timer;
+			auto const& h = interval.histogram;
+
+			out << (first ? "\n" : ",\n") << "      {\"start\": ";
+			first = false;
+			number(std::chrono::duration<double>(interval.start.time_since_epoch()).count())
+			    << ", \"samples\": " << t.numSamples() << ", \"mean\": ";
+			number(t.meanSeconds()) << ", \"max\": ";
+			number(t.maxSeconds()) << ", \"p50\": ";
+			number(h.percentileSeconds(50)) << ", \"p90\": ";
+			number(h.percentileSeconds(90)) << ", \"p99\": ";
+			number(h.percentileSeconds(99)) << ", \"histogram\": [";
+			bool first_bucket = true;
+			for (auto const& [lower, upper, count] : h.buckets()) {
+				out << (first_bucket ? "[" : ", [");
+				first_bucket = false;
+				number(std::chrono::duration<double>(lower).count()) << ", ";
+				number(std::chrono::duration<double>(upper).count()) << ", " << count << ']';
+			}
+			out << "]}";
+		}
+		out << (first ? "]}" : "\n    ]}");
+	}
+	out << (rings_.empty() ? "]\n}\n" : "\n  ]\n}\n");
+
+	out.flags(flags);
+	out.precision(prec);
+}
+
+std::size_t TimeSeries::memoryUsage() const
+{
+	std::size_t bytes = sizeof(TimeSeries) + rings_.capacity() * sizeof(Ring);
+	for (auto const& r : rings_) {
+		bytes += r.slots.capacity() * sizeof(Slot);
+		for (auto const& s : r.slots) {
+			bytes += s.histogram.memoryUsage();
+		}
+	}
+	return bytes;
+}
+}  // namespace ufo
@@ -0,0 +1,213 @@
+// UFO
+#include <ufo/time/timed_mutex.hpp>
+
+namespace ufo
+{
+//
+// Public functions
+//
+
+LockStats TimedLockable::stats() const
+{
+	lockQuietly();
+	auto uncontended = uncontended_;
+	unlockQuietly();
+
+	std::lock_guard lock(stats_mutex_);
+	LockStats       res = stats_;
+
+	res.uncontended        = uncontended;
+	res.shared_uncontended = shared_uncontended_.load(std::memory_order_relaxed);
+	return res;
+}
+
+void TimedLockable::resetStats()
+{
+	lockQuietly();
+	uncontended_ = 0;
+	unlockQuietly();
+
+	std::lock_guard lock(stats_mutex_);
+	stats_ = {};
+	shared_uncontended_.store(0, std::memory_order_relaxed);
+}
+
+TimedMutex::TimedMutex(std::size_t hold_sample_period)
+    : TimedLockable(hold_sample_period)
+{
+}
+
+TimedMutex::TimedMutex(Timing& timing, std::size_t hold_sample_period)
+    : TimedLockable(timing, hold_sample_period)
+{
+}
+
+void TimedMutex::unlock()
+{
+	if (decltype(hold_start_){} == hold_start_) {
+		mutex_.unlock();
+		return;
+	}
+
+	auto start     = hold_start_;
+	bool contended = hold_contended_;
+	auto stop      = std::chrono::high_resolution_clock::now();
+	mutex_.unlock();
+	addHold(start, stop, contended);
+}
+
+TimedSharedMutex::TimedSharedMutex(std::size_t hold_sample_period)
+    : TimedLockable(hold_sample_period)
+{
+}
+
+TimedSharedMutex::TimedSharedMutex(Timing& timing, std::size_t hold_sample_period)
+    : TimedLockable(timing, hold_sample_period)
+{
+}
+
+void TimedSharedMutex::unlock()
+{
+	if (decltype(hold_start_){} == hold_start_) {
+		mutex_.unlock();
+		return;
+	}
+
+	auto start     = hold_start_;
+	bool contended = hold_contended_;
+	auto stop      = std::chrono::high_resolution_clock::now();
+	mutex_.unlock();
+	addHold(start, stop, contended);
+}
+
+TimedConditionVariable::TimedConditionVariable(Timing& timing)
+    : timing_(&timing["Condition wait"])
+{
+}
+
+void TimedConditionVariable::notify_one() noexcept { cv_.notify_one(); }
+
+void TimedConditionVariable::notify_all() noexcept { cv_.notify_all(); }
+
+Timer TimedConditionVariable::waitTimer() const
+{
+	std::lock_guard lock(stats_mutex_);
+	return wait_;
+}
+
+std::uint64_t TimedConditionVariable::timeouts() const
+{
+	std::lock_guard lock(stats_mutex_);
+	return timeouts_;
+}
+
+void TimedConditionVariable::resetStats()
+{
+	std::lock_guard lock(stats_mutex_);
+	wait_.reset();
+	timeouts_ = 0;
+}
+
+//
+// Private functions
+//
+
+TimedLockable::TimedLockable(std::size_t hold_sample_period)
+    : hold_sample_period_(hold_sample_period)
+{
+}
+
+TimedLockable::TimedLockable(Timing& timing, std::size_t hold_sample_period)
+    : hold_sample_period_(hold_sample_period)
+    , wait_timing_(&timing["Contended wait"])
+    , shared_wait_timing_(&timing["Shared wait"])
+    , hold_contended_timing_(&timing["Contended hold"])
+    , hold_uncontended_timing_(&timing["Uncontended hold"])
+{
+}
+
+void TimedLockable::addWait(
+    std::chrono::time_point<std::chrono::high_resolution_clock> start,
+    std::chrono::time_point<std::chrono::high_resolution_clock> stop, bool shared)
+{
+	{
+		std::lock_guard lock(stats_mutex_);
+		if (shared) {
+			++stats_.shared_contended;
+			stats_.shared_wait.addSample(start, stop);
+		} else {
+			++stats_.contended;
+			stats_.wait.addSample(start, stop);
+		}
+	}
+
+	if (auto t = shared ? shared_wait_timing_ : wait_timing_; nullptr != t) {
+		t->addSample(start, stop);
+	}
+}
+
+void TimedLockable::addHold(
+    std::chrono::time_point<std::chrono::high_resolution_clock> start,
+    std::chrono::time_point<std::chrono::high_resolution_clock> stop, bool contended)
+{
+	{
+		std::lock_guard lock(stats_mutex_);
+		(contended ? stats_.hold_contended : stats_.hold_uncontended).addSample(start, stop);
+	}
+
+	if (auto t = contended ? hold_contended_timing_ : hold_uncontended_timing_;
+	    nullptr != t) {
+		t->addSample(start, stop);
+	}
+}
+
+void TimedMutex::lockContended()
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	mutex_.lock();
+	auto now        = std::chrono::high_resolution_clock::now();
+	hold_start_     = now;
+	hold_contended_ = true;
+	addWait(start, now, false);
+}
+
+void TimedMutex::lockQuietly() const { mutex_.lock(); }
+
+void TimedMutex::unlockQuietly() const { mutex_.unlock(); }
+
+void TimedSharedMutex::lockContended()
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	mutex_.lock();
+	auto now        = std::chrono::high_resolution_clock::now();
+	hold_start_     = now;
+	hold_contended_ = true;
+	addWait(start, now, false);
+}
+
+void TimedSharedMutex::lockQuietly() const { mutex_.lock(); }
+
+void TimedSharedMutex::unlockQuietly() const { mutex_.unlock(); }
+
+void TimedSharedMutex::lockSharedContended()
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	mutex_.lock_shared();
+	addWait(start, std::chrono::high_resolution_clock::now(), true);
+}
+
+void TimedConditionVariable::addWait(
+    std::chrono::time_point<std::chrono::high_resolution_clock> start,
+    std::chrono::time_point<std::chrono::high_resolution_clock> stop, bool timeout)
+{
+	{
+		std::lock_guard lock(stats_mutex_);
+		wait_.addSample(start, stop);
+		timeouts_ += timeout;
+	}
+
+	if (nullptr != timing_) {
+		timing_->addSample(start, stop);
+	}
+}
+}  // namespace ufo
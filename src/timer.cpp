@@ -1,21 +1,98 @@
 // UFO
 #include <ufo/time/timer.hpp>
 
+// STL
+#include <algorithm>
+#include <limits>
+
+// Compile the bulk kernels for several instruction sets and pick at load time
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__ELF__)
+#define UFO_TIME_TARGET_CLONES \
+	__attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define UFO_TIME_TARGET_CLONES
+#endif
+
 namespace ufo
 {
-//
-// Public functions
-//
+namespace
+{
+// Samples are combined into the timer one block at a time, small enough to stay in the
+// cache between the two passes over it
+constexpr std::size_t BLOCK_SIZE = 1024;
+
+// Independent accumulators, so the loops vectorize instead of forming one long
+// dependency chain
+constexpr std::size_t LANES = 8;
+
+struct Moments {
+	std::chrono::high_resolution_clock::rep sum;
+	std::chrono::high_resolution_clock::rep min;
+	std::chrono::high_resolution_clock::rep max;
+	// In ticks squared
+	double sum_squares_diffs;
+};
+
+UFO_TIME_TARGET_CLONES Moments
+moments(std::chrono::high_resolution_clock::duration const* x, std::size_t n)
+{
+	using Rep = std::chrono::high_resolution_clock::rep;
+
+	std::array<Rep, LANES> sum{};
+	std::array<Rep, LANES> min;
+	std::array<Rep, LANES> max;
+	min.fill(std::numeric_limits<Rep>::max());
+	max.fill(std::numeric_limits<Rep>::lowest());
+
+	std::size_t i{};
+	for (; n >= i + LANES; i += LANES) {
+		for (std::size_t l{}; LANES > l; ++l) {
+			Rep v = x[i + l].count();
+			sum[l] += v;
+			min[l] = std::min(min[l], v);
+			max[l] = std::max(max[l], v);
+		}
+	}
+	for (; n > i; ++i) {
+		Rep v = x[i].count();
+		sum[0] += v;
+		min[0] = std::min(min[0], v);
+		max[0] = std::max(max[0], v);
+	}
 
-void Timer::start() { start(std::chrono::high_resolution_clock::now()); }
+	Moments res{0, min[0], max[0], 0.0};
+	for (std::size_t l{}; LANES > l; ++l) {
+		res.sum += sum[l];
+		res.min = std::min(res.min, min[l]);
+		res.max = std::max(res.max, max[l]);
+	}
 
-void Timer::pause()
-{
-	current_ += std::chrono::high_resolution_clock::now() - start_;
-	start_ = {};
+	// Second pass around the exact mean of the block, which is numerically as good as
+	// Welford's update without its division per sample
+	double const              mean = static_cast<double>(res.sum) / static_cast<double>(n);
+	std::array<double, LANES> ssd{};
+	for (i = 0; n >= i + LANES; i += LANES) {
+		for (std::size_t l{}; LANES > l; ++l) {
+			double d = static_cast<double>(x[i + l].count()) - mean;
+			ssd[l] += d * d;
+		}
+	}
+	for (; n > i; ++i) {
+		double d = static_cast<double>(x[i].count()) - mean;
+		ssd[0] += d * d;
+	}
+
+	for (std::size_t l{}; LANES > l; ++l) {
+		res.sum_squares_diffs += ssd[l];
+	}
+
+	return res;
 }
+}  // namespace
 
-void Timer::resume() { start(); }
+//
+// Public functions
+//
 
 void Timer::reset()
 {
@@ -32,13 +109,51 @@ void Timer::reset()
 	max_               = std::chrono::high_resolution_clock::duration::min();
 }
 
-void Timer::resetCurrent()
+void Timer::addSamples(std::chrono::high_resolution_clock::duration const* samples,
+                       std::size_t                                         count)
 {
-	start_   = {};
-	current_ = std::chrono::high_resolution_clock::duration::zero();
+	constexpr double s =
+	    static_cast<double>(std::chrono::high_resolution_clock::period::num) /
+	    static_cast<double>(std::chrono::high_resolution_clock::period::den);
+
+	for (std::size_t i{}; count > i; i += BLOCK_SIZE) {
+		auto n = std::min(BLOCK_SIZE, count - i);
+		auto m = moments(samples + i, n);
+		combine(static_cast<int>(n), std::chrono::high_resolution_clock::duration(m.sum),
+		        std::chrono::duration<double, std::chrono::high_resolution_clock::period>(
+		            static_cast<double>(m.sum) / static_cast<double>(n)),
+		        m.sum_squares_diffs * s * s,
+		        std::chrono::high_resolution_clock::duration(m.min),
+		        std::chrono::high_resolution_clock::duration(m.max));
+	}
 }
 
-void Timer::stop() { stop(std::chrono::high_resolution_clock::now()); }
+void Timer::addSamples(
+    std::pair<std::chrono::time_point<std::chrono::high_resolution_clock>,
+              std::chrono::time_point<std::chrono::high_resolution_clock>> const* samples,
+    std::size_t                                                                  count)
+{
+	// The last sample is the one that stopped last, not the last one in `samples`
+	auto last_time_point = last_time_point_;
+	auto last            = last_;
+
+	std::array<std::chrono::high_resolution_clock::duration, BLOCK_SIZE> elapsed;
+	for (std::size_t i{}; count > i; i += BLOCK_SIZE) {
+		auto n = std::min(BLOCK_SIZE, count - i);
+		for (std::size_t j{}; n > j; ++j) {
+			auto const& [start, stop] = samples[i + j];
+			elapsed[j]                = stop - start;
+			if (last_time_point < stop) {
+				last_time_point = stop;
+				last            = elapsed[j];
+			}
+		}
+		addSamples(elapsed.data(), n);
+	}
+
+	last_time_point_ = last_time_point;
+	last_            = last;
+}
 
 Timer& Timer::operator+=(Timer rhs)
 {
@@ -52,16 +167,8 @@ Timer& Timer::operator+=(Timer rhs)
 		last_            = rhs.last_;
 	}
 
-	mean_ = 0 == samples_ + rhs.samples_
-	            ? std::chrono::duration<double,
-	                                    std::chrono::high_resolution_clock::period>::zero()
-	            : (total_ + rhs.total_) / static_cast<double>(samples_ + rhs.samples_);
-
-	samples_ += rhs.samples_;
-	total_ += rhs.total_;
-	sum_squares_diffs_ += rhs.sum_squares_diffs_;
-	min_ = std::min(min_, rhs.min_);
-	max_ = std::max(max_, rhs.max_);
+	combine(rhs.samples_, rhs.total_, rhs.mean_, rhs.sum_squares_diffs_, rhs.min_,
+	        rhs.max_);
 
 	return *this;
 }
@@ -87,12 +194,34 @@ Timer& Timer::operator-=(Timer rhs)
 		rhs.stop(now);
 	}
 
-	samples_ -= rhs.samples_;
-	total_ -= rhs.total_;
-	mean_ -= rhs.mean_;
-	sum_squares_diffs_ -= rhs.sum_squares_diffs_;
-	min_ -= std::min(min_, rhs.min_);
-	max_ -= std::max(max_, rhs.max_);
+	using Duration = std::chrono::high_resolution_clock::duration;
+
+	if (samples_ <= rhs.samples_) {
+		samples_           = 0;
+		total_             = Duration::zero();
+		mean_              = decltype(mean_)::zero();
+		sum_squares_diffs_ = 0.0;
+		min_               = Duration::max();
+		max_               = Duration::min();
+		return *this;
+	}
+
+	// Inverse of `combine`, the mean from the exact total
+	double n_a   = rhs.samples_;
+	double n_b   = samples_ - rhs.samples_;
+	auto   total = total_ - rhs.total_;
+	auto   mean  = std::chrono::duration<double, Duration::period>(total) / n_b;
+	double d     = toDouble<std::chrono::seconds::period>(mean - rhs.mean_);
+	double ssd   = sum_squares_diffs_ - rhs.sum_squares_diffs_ -
+	             d * d * (n_a * n_b / (n_a + n_b));
+
+	samples_           = static_cast<int>(n_b);
+	total_             = total;
+	mean_              = mean;
+	sum_squares_diffs_ = std::max(0.0, ssd);
+	// The extremes are only known if they are not also in `rhs`
+	min_ = min_ < rhs.min_ ? min_ : Duration::max();
+	max_ = max_ > rhs.max_ ? max_ : Duration::min();
 
 	return *this;
 }
@@ -111,16 +240,6 @@ Timer operator-(Timer lhs, Timer rhs)
 	return lhs;
 }
 
-bool Timer::running() const
-{
-	return std::chrono::time_point<std::chrono::high_resolution_clock>{} != start_;
-}
-
-bool Timer::paused() const
-{
-	return !running() && std::chrono::high_resolution_clock::duration::zero() != current_;
-}
-
 double Timer::currentSeconds() const { return current<std::chrono::seconds::period>(); }
 
 double Timer::currentMilliseconds() const
@@ -264,59 +383,31 @@ double Timer::populationVarianceNanoseconds() const
 	return populationVariance<std::chrono::nanoseconds::period>();
 }
 
-int Timer::numSamples() const { return samples_; }
-
 //
 // Private functions
 //
 
-void Timer::start(std::chrono::time_point<std::chrono::high_resolution_clock> time)
-{
-	start_ = time;
-}
-
-void Timer::stop(std::chrono::time_point<std::chrono::high_resolution_clock> time)
+void Timer::combine(
+    int samples, std::chrono::high_resolution_clock::duration total,
+    std::chrono::duration<double, std::chrono::high_resolution_clock::period> mean,
+    double sum_squares_diffs, std::chrono::high_resolution_clock::duration min,
+    std::chrono::high_resolution_clock::duration max)
 {
-	last_time_point_ = time;
-
-	last_ = paused() ? current_ : current_ + (time - start_);
-
-	start_   = {};
-	current_ = std::chrono::high_resolution_clock::duration::zero();
-
-	++samples_;
-
-	auto delta_1 = std::chrono::duration<double>(last_ - mean_);
-	mean_ += delta_1 / samples_;
-	auto delta_2 = std::chrono::duration<double>(last_ - mean_);
-	sum_squares_diffs_ += toDouble<std::chrono::seconds::period>(delta_1) *
-	                      toDouble<std::chrono::seconds::period>(delta_2);
-
-	total_ += last_;
-	min_ = std::min(min_, last_);
-	max_ = std::max(max_, last_);
-}
-
-void Timer::addSample(std::chrono::time_point<std::chrono::high_resolution_clock> start,
-                      std::chrono::time_point<std::chrono::high_resolution_clock> stop)
-{
-	auto elapsed = stop - start;
-
-	if (last_time_point_ < stop) {
-		last_time_point_ = stop;
-		last_            = elapsed;
+	if (0 == samples) {
+		return;
 	}
 
-	++samples_;
+	double n_a   = samples_;
+	double n_b   = samples;
+	auto   delta = mean - mean_;
+	double d     = toDouble<std::chrono::seconds::period>(delta);
 
-	auto delta_1 = std::chrono::duration<double>(elapsed - mean_);
-	mean_ += delta_1 / samples_;
-	auto delta_2 = std::chrono::duration<double>(elapsed - mean_);
-	sum_squares_diffs_ += toDouble<std::chrono::seconds::period>(delta_1) *
-	                      toDouble<std::chrono::seconds::period>(delta_2);
+	mean_ += delta * (n_b / (n_a + n_b));
+	sum_squares_diffs_ += sum_squares_diffs + d * d * (n_a * n_b / (n_a + n_b));
 
-	total_ += elapsed;
-	min_ = std::min(min_, elapsed);
-	max_ = std::max(max_, elapsed);
+	samples_ += samples;
+	total_ += total;
+	min_ = std::min(min_, min);
+	max_ = std::max(max_, max);
 }
 }  // namespace ufo
\ No newline at end of file
@@ -1,13 +1,99 @@
 // UFO
+#include <ufo/time/journal.hpp>
+#include <ufo/time/probes.hpp>
 #include <ufo/time/timing.hpp>
 
 // STL
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <deque>
 #include <stack>
 
 namespace ufo
 {
+namespace
+{
+// Invokes the deferred budget callbacks, in order, on a background thread
+class BudgetDispatcher
+{
+ public:
+	static BudgetDispatcher& instance()
+	{
+		static BudgetDispatcher dispatcher;
+		return dispatcher;
+	}
+
+	void post(std::function<void()> f)
+	{
+		{
+			std::lock_guard lock(mutex_);
+			queue_.push_back(std::move(f));
+		}
+		cv_.notify_one();
+	}
+
+	~BudgetDispatcher()
+	{
+		{
+			std::lock_guard lock(mutex_);
+			done_ = true;
+		}
+		cv_.notify_one();
+		worker_.join();
+	}
+
+ private:
+	BudgetDispatcher() : worker_([this]() { run(); }) {}
+
+	void run()
+	{
+		std::unique_lock lock(mutex_);
+		while (true) {
+			cv_.wait(lock, [this]() { return done_ || !queue_.empty(); });
+			if (queue_.empty()) {
+				return;
+			}
+			auto f = std::move(queue_.front());
+			queue_.pop_front();
+			lock.unlock();
+			f();
+			lock.lock();
+		}
+	}
+
+ private:
+	std::mutex                        mutex_;
+	std::condition_variable           cv_;
+	std::deque<std::function<void()>> queue_;
+	bool                              done_ = false;
+	std::thread                       worker_;
+};
+
+// Heap bytes of a string holding `size` characters, zero if it fits the small-string
+// buffer
+std::size_t stringHeap(std::size_t size)
+{
+	static std::size_t const inline_capacity = std::string().capacity();
+	return inline_capacity < size ? size + 1 : 0;
+}
+
+// `std::printf` into `out`
+template <class... Args>
+void formatTo(std::ostream& out, char const* format, Args... args)
+{
+	int         n = std::snprintf(nullptr, 0, format, args...);
+	std::string s(0 < n ? n : 0, '\0');
+	std::snprintf(s.data(), s.size() + 1, format, args...);
+	out << s;
+}
+}  // namespace
+
+thread_local Timing* Timing::scope_ = nullptr;
+
 //
 // Public functions
 //
@@ -97,37 +183,51 @@ Timing& Timing::start(std::string const& tag)
 	auto start = std::chrono::high_resolution_clock::now();
 	auto id    = std::this_thread::get_id();
 
-	for (auto p = this; nullptr != p; p = p->parent_) {
-		std::lock_guard lock(p->mutex_);
+	{
+		std::lock_guard lock(mutex_);
 		auto [it, added] = thread_.try_emplace(id);
 		if (added) {
 			it->second.independent = false;
 			it->second.start       = start;
 			it->second.extra_time  = std::chrono::high_resolution_clock::duration::zero();
 		}
-		p->updateMaxConcurrent();
 	}
 
-	Timing* parent = this;
-	if (0 < thread_.count(id)) {
-		parent = findDeepest(id);
+	for (auto p = this; nullptr != p; p = p->parent_) {
+		std::lock_guard lock(p->mutex_);
+		p->updateMaxConcurrent();
 	}
 
-	parent->lock_.lock();
+	Timing* parent = findDeepest(id);
 
-	auto& new_timing = parent->children_.try_emplace(tag, tag).first->second;
-	new_timing.lock_.lock();
-	new_timing.parent_ = parent;
+	parent->mutex_.lock();
 
-	parent->lock_.unlock();
+	auto& new_timing = parent->child(tag);
+	new_timing.mutex_.lock();
 
-	auto& st = new_timing.thread_[id];
-	new_timing.updateMaxConcurrent();
-	new_timing.lock_.unlock();
+	parent->mutex_.unlock();
 
+	// Set under the lock as `trackThreads` reads it from other threads, the extra time is
+	// only accessed by this thread
+	auto& st       = new_timing.thread_[id];
 	st.independent = true;
 	st.start       = start;
-	st.extra_time  = std::chrono::high_resolution_clock::now() - start;
+	st.extra_time  = std::chrono::high_resolution_clock::duration::zero();
+	new_timing.updateMaxConcurrent();
+	if (new_timing.threads_) {
+		++new_timing.threads_->running;
+	}
+	auto journal = new_timing.journal_;
+	new_timing.mutex_.unlock();
+
+	if (journal) {
+		journal->start(new_timing, start);
+	}
+
+	scope_ = &new_timing;
+	UFOTIME_PROBE3(timing__start, &new_timing, parent, new_timing.tag_.c_str());
+
+	st.extra_time = std::chrono::high_resolution_clock::now() - start;
 
 	return new_timing;
 }
@@ -139,46 +239,17 @@ Timing& Timing::start(std::string const& tag, char const* color)
 	return ret;
 }
 
-bool Timing::stop()
-{
-	// TODO: Implement correct
-
-	auto time = std::chrono::high_resolution_clock::now();
-	auto id   = std::this_thread::get_id();
-
-	lock_.lock();
-	if (0 == thread_.count(id)) {
-		lock_.unlock();
-		return false;
-	}
-
-	Timing* current = findDeepest(id);
-
-	lock_.unlock();
-
-	current->lock_.lock();
+bool Timing::stop() { return stop({}); }
 
-	auto& st = current->thread_[id];
-	auto  et = st.extra_time;
-	current->timer_.addSample(st.start + et, time);
-	current->thread_.erase(id);
-
-	Timing* parent = current->parent_;
-
-	current->lock_.unlock();
-
-	if (nullptr != parent) {
-		parent->lock_.lock();
-		auto& st = parent->thread_[id];
-		parent->lock_.unlock();
-		time -= st.extra_time + et;
-		st.extra_time = std::chrono::high_resolution_clock::now() - time;
-	}
-
-	return true;
+bool Timing::stop(std::initializer_list<std::pair<std::string const, double>> work)
+{
+	return stopImpl(work, nullptr);
+}
 
-	// auto time = std::chrono::high_resolution_clock::now();
-	// return 1 == stop(time, 1);
+bool Timing::stopWithSize(
+    std::size_t size, std::initializer_list<std::pair<std::string const, double>> work)
+{
+	return stopImpl(work, &size);
 }
 
 std::size_t Timing::stop(std::size_t levels)
@@ -193,6 +264,28 @@ void Timing::stopAll()
 	stop(time, std::numeric_limits<std::size_t>::max());
 }
 
+void Timing::addSample(std::chrono::time_point<std::chrono::high_resolution_clock> start,
+                       std::chrono::time_point<std::chrono::high_resolution_clock> stop)
+{
+	std::lock_guard lock(mutex_);
+	timer_.addSample(start, stop);
+	if (series_) {
+		series_->add(start, stop);
+	}
+}
+
+void Timing::addSample(std::chrono::time_point<std::chrono::high_resolution_clock> start,
+                       std::chrono::time_point<std::chrono::high_resolution_clock> stop,
+                       std::size_t                                                 size)
+{
+	std::lock_guard lock(mutex_);
+	timer_.addSample(start, stop);
+	if (series_) {
+		series_->add(start, stop);
+	}
+	addSizeSample(size, start, stop);
+}
+
 Timing const& Timing::operator[](std::string const& tag) const
 {
 	std::lock_guard lock(mutex_);
@@ -202,7 +295,7 @@ Timing const& Timing::operator[](std::string const& tag) const
 Timing& Timing::operator[](std::string const& tag)
 {
 	std::lock_guard lock(mutex_);
-	return children_[tag];
+	return child(tag);
 }
 
 void Timing::extend(Timing const& source)
@@ -241,6 +334,414 @@ void Timing::merge(std::initializer_list<Timing> ilist)
 
 std::string const& Timing::tag() const { return tag_; }
 
+Timer Timing::timer() const
+{
+	std::lock_guard lock(mutex_);
+	return timer_;
+}
+
+std::map<std::string, double> Timing::work() const
+{
+	std::lock_guard lock(mutex_);
+	return work_;
+}
+
+std::map<std::string, double> Timing::workSeconds() const
+{
+	std::lock_guard               lock(mutex_);
+	std::map<std::string, double> res;
+	for (auto const& [name, time] : work_time_) {
+		res[name] = std::chrono::duration<double>(time).count();
+	}
+	return res;
+}
+
+std::vector<Timing::SizeBucket> Timing::sizeBuckets() const
+{
+	std::lock_guard lock(mutex_);
+	return sizeBucketsImpl();
+}
+
+ComplexityFit Timing::complexity() const
+{
+	std::vector<double> sizes;
+	std::vector<double> seconds;
+	std::vector<double> weights;
+	for (auto const& b : sizeBuckets()) {
+		sizes.push_back(b.mean_size);
+		seconds.push_back(b.timer.meanSeconds());
+		weights.push_back(b.timer.numSamples());
+	}
+	return fitComplexity(sizes, seconds, weights);
+}
+
+void Timing::setBudget(std::chrono::high_resolution_clock::duration budget,
+                       BudgetCallback callback, bool deferred)
+{
+	std::lock_guard lock(mutex_);
+	budget_          = budget;
+	budget_callback_ = callback ? std::make_shared<BudgetCallback const>(std::move(callback))
+	                            : nullptr;
+	budget_deferred_ = deferred;
+}
+
+void Timing::clearBudget()
+{
+	std::lock_guard lock(mutex_);
+	budget_ = std::chrono::high_resolution_clock::duration::max();
+	budget_callback_.reset();
+	budget_deferred_ = false;
+}
+
+bool Timing::hasBudget() const
+{
+	std::lock_guard lock(mutex_);
+	return std::chrono::high_resolution_clock::duration::max() != budget_;
+}
+
+std::chrono::high_resolution_clock::duration Timing::budget() const
+{
+	std::lock_guard lock(mutex_);
+	return budget_;
+}
+
+std::size_t Timing::deadlineMisses() const
+{
+	std::lock_guard lock(mutex_);
+	return deadline_misses_;
+}
+
+void Timing::frame(std::size_t slowest)
+{
+	auto now = std::chrono::high_resolution_clock::now();
+
+	std::lock_guard lock(mutex_);
+
+	if (!frames_) {
+		frames_ = std::make_unique<Frames>();
+	}
+	auto& f       = *frames_;
+	f.num_slowest = slowest;
+
+	// Min-heap on the period, so the fastest of the kept frames are dropped first
+	auto cmp = [](Frame const& a, Frame const& b) { return a.period > b.period; };
+	while (f.slowest.size() > f.num_slowest) {
+		std::pop_heap(std::begin(f.slowest), std::end(f.slowest), cmp);
+		f.slowest.pop_back();
+	}
+
+	bool first = decltype(f.last){} == f.last;
+
+	Frame frame;
+	frame.index  = f.num;
+	frame.start  = f.last;
+	frame.period = now - f.last;
+
+	for (auto& [tag, child] : children_) {
+		std::lock_guard child_lock(child.mutex_);
+		auto&           fc    = f.children[tag];
+		auto            total = child.timer_.total_;
+		if (!first) {
+			frame.children.emplace_back(tag, total - fc.last_total);
+		}
+		fc.last_total = total;
+	}
+
+	f.last = now;
+
+	if (first) {
+		return;
+	}
+
+	++f.num;
+	f.period.addSample(frame.start, now);
+	f.histogram.add(frame.period);
+	for (auto const& [tag, d] : frame.children) {
+		auto& fc = f.children[tag];
+		fc.timer.addSample(now - d, now);
+		fc.histogram.add(d);
+	}
+
+	if (f.slowest.size() < f.num_slowest) {
+		f.slowest.push_back(std::move(frame));
+		std::push_heap(std::begin(f.slowest), std::end(f.slowest), cmp);
+	} else if (!f.slowest.empty() && f.slowest.front().period < frame.period) {
+		std::pop_heap(std::begin(f.slowest), std::end(f.slowest), cmp);
+		f.slowest.back() = std::move(frame);
+		std::push_heap(std::begin(f.slowest), std::end(f.slowest), cmp);
+	}
+}
+
+std::size_t Timing::numFrames() const
+{
+	std::lock_guard lock(mutex_);
+	return frames_ ? frames_->num : 0;
+}
+
+Timer Timing::framePeriod() const
+{
+	std::lock_guard lock(mutex_);
+	return frames_ ? frames_->period : Timer{};
+}
+
+Histogram Timing::framePeriodHistogram() const
+{
+	std::lock_guard lock(mutex_);
+	return frames_ ? frames_->histogram : Histogram{};
+}
+
+std::vector<Timing::Frame> Timing::slowestFrames() const
+{
+	std::lock_guard lock(mutex_);
+	return sortedSlowestFrames();
+}
+
+std::string Timing::Frame::dominant() const
+{
+	auto it = std::max_element(
+	    std::begin(children), std::end(children),
+	    [](auto const& a, auto const& b) { return a.second < b.second; });
+	return std::end(children) == it ? "" : it->first;
+}
+
+void Timing::captureSlowest(std::size_t num)
+{
+	std::lock_guard lock(mutex_);
+	if (0 == num) {
+		slowest_.reset();
+		return;
+	}
+
+	if (!slowest_) {
+		slowest_ = std::make_unique<SlowestSamples>();
+	}
+	slowest_->num = num;
+
+	auto cmp = [](Sample const& a, Sample const& b) { return a.duration > b.duration; };
+	while (slowest_->samples.size() > num) {
+		std::pop_heap(std::begin(slowest_->samples), std::end(slowest_->samples), cmp);
+		slowest_->samples.pop_back();
+	}
+}
+
+std::size_t Timing::numCaptureSlowest() const
+{
+	std::lock_guard lock(mutex_);
+	return slowest_ ? slowest_->num : 0;
+}
+
+std::vector<Timing::Sample> Timing::slowestSamples() const
+{
+	std::lock_guard lock(mutex_);
+	if (!slowest_) {
+		return {};
+	}
+
+	auto res = slowest_->samples;
+	std::sort(std::begin(res), std::end(res),
+	          [](Sample const& a, Sample const& b) { return a.duration > b.duration; });
+	return res;
+}
+
+void Timing::trackThreads(bool enable)
+{
+	std::lock_guard lock(mutex_);
+	if (!enable) {
+		threads_.reset();
+		return;
+	}
+
+	if (threads_) {
+		return;
+	}
+
+	threads_ = std::make_unique<Threads>();
+	// Threads already running this are part of the first parallel section
+	for (auto const& [_, st] : thread_) {
+		threads_->running += st.independent;
+	}
+}
+
+bool Timing::tracksThreads() const
+{
+	std::lock_guard lock(mutex_);
+	return nullptr != threads_;
+}
+
+void Timing::recordSeries(std::vector<TimeSeries::Resolution> const& resolutions)
+{
+	std::lock_guard lock(mutex_);
+	if (resolutions.empty()) {
+		series_.reset();
+		return;
+	}
+
+	series_ = std::make_unique<TimeSeries>(resolutions);
+}
+
+bool Timing::recordsSeries() const
+{
+	std::lock_guard lock(mutex_);
+	return nullptr != series_;
+}
+
+TimeSeries Timing::series() const
+{
+	std::lock_guard lock(mutex_);
+	return series_ ? *series_ : TimeSeries(std::vector<TimeSeries::Resolution>{});
+}
+
+std::map<std::thread::id, Timer> Timing::threadTimers() const
+{
+	std::lock_guard lock(mutex_);
+	return threads_ ? threads_->timers : std::map<std::thread::id, Timer>{};
+}
+
+Timer Timing::wallTimer() const
+{
+	std::lock_guard lock(mutex_);
+	return threads_ ? threads_->wall : Timer{};
+}
+
+double Timing::imbalance() const
+{
+	std::lock_guard lock(mutex_);
+	return imbalanceImpl();
+}
+
+double Timing::parallelEfficiency() const
+{
+	std::lock_guard lock(mutex_);
+	return parallelEfficiencyImpl();
+}
+
+std::thread::id Timing::slowestThread() const
+{
+	std::lock_guard lock(mutex_);
+	if (!threads_ || threads_->timers.empty()) {
+		return {};
+	}
+
+	auto it = std::max_element(
+	    std::begin(threads_->timers), std::end(threads_->timers),
+	    [](auto const& a, auto const& b) { return a.second.total_ < b.second.total_; });
+	return it->first;
+}
+
+void Timing::setJournal(std::shared_ptr<Journal> journal)
+{
+	std::lock_guard lock(mutex_);
+	journal_ = journal;
+	for (auto& [_, child] : children_) {
+		child.setJournal(journal);
+	}
+}
+
+void Timing::setLimits(std::size_t max_children, std::size_t max_nodes,
+                       std::size_t max_bytes)
+{
+	auto limits          = std::make_shared<Limits>();
+	limits->max_children = max_children;
+	limits->max_nodes    = max_nodes;
+	limits->max_bytes    = max_bytes;
+	limits->nodes        = numNodes();
+	limits->bytes        = treeBytes();
+	setLimitsRecurs(limits);
+}
+
+void Timing::clearLimits() { setLimitsRecurs(nullptr); }
+
+std::size_t Timing::numOverflows() const
+{
+	std::lock_guard lock(mutex_);
+	return limits_ ? limits_->overflows.load() : 0;
+}
+
+std::size_t Timing::compact(std::size_t max_nodes)
+{
+	std::size_t folded{};
+	for (auto nodes = numNodes(); max_nodes < nodes;) {
+		std::vector<std::pair<double, Timing*>> leaves;
+		foldableRecurs(leaves);
+		std::sort(std::begin(leaves), std::end(leaves));
+
+		for (auto [_, leaf] : leaves) {
+			if (max_nodes >= nodes) {
+				break;
+			}
+			if (leaf->parent_->fold(*leaf, nodes)) {
+				++folded;
+			}
+		}
+
+		// Folding can add an `otherTag()` node, stop when nothing more can be removed
+		auto remaining = numNodes();
+		if (remaining >= nodes) {
+			break;
+		}
+		nodes = remaining;
+	}
+	return folded;
+}
+
+std::size_t Timing::numNodes() const
+{
+	std::lock_guard lock(mutex_);
+	std::size_t     nodes = 1;
+	for (auto const& [_, child] : children_) {
+		nodes += child.numNodes();
+	}
+	return nodes;
+}
+
+std::size_t Timing::memoryUsage() const
+{
+	auto heap = [](std::string const& s) { return stringHeap(s.capacity()); };
+	// Red-black tree node header of std::map
+	constexpr std::size_t MAP_NODE = 4 * sizeof(void*);
+
+	std::lock_guard lock(mutex_);
+
+	std::size_t bytes = sizeof(Timing) + heap(tag_) + heap(color_);
+	bytes += thread_.size() * (MAP_NODE + sizeof(decltype(thread_)::value_type));
+	for (auto const& [name, _] : work_) {
+		bytes += 2 * MAP_NODE + sizeof(decltype(work_)::value_type) +
+		         sizeof(decltype(work_time_)::value_type) + 2 * heap(name);
+	}
+	bytes += sizes_.capacity() * sizeof(SizeStats);
+	if (series_) {
+		bytes += series_->memoryUsage();
+	}
+	if (frames_) {
+		bytes += sizeof(Frames) + frames_->histogram.memoryUsage() +
+		         frames_->slowest.capacity() * sizeof(Frame);
+		for (auto const& f : frames_->slowest) {
+			bytes += f.children.capacity() * sizeof(decltype(f.children)::value_type);
+		}
+		for (auto const& [tag, child] : frames_->children) {
+			bytes += MAP_NODE + sizeof(decltype(frames_->children)::value_type) + heap(tag) +
+			         child.histogram.memoryUsage();
+		}
+	}
+	if (slowest_) {
+		bytes += sizeof(SlowestSamples) + slowest_->samples.capacity() * sizeof(Sample);
+		for (auto const& sample : slowest_->samples) {
+			bytes += sample.path.capacity() * sizeof(std::string);
+		}
+	}
+	if (threads_) {
+		auto const& th = *threads_;
+		bytes += sizeof(Threads) +
+		         th.timers.size() * (MAP_NODE + sizeof(decltype(th.timers)::value_type)) +
+		         th.section_threads.size() * (MAP_NODE + sizeof(std::thread::id));
+	}
+	for (auto const& [tag, child] : children_) {
+		// The child itself is counted by its `memoryUsage`
+		bytes += MAP_NODE + sizeof(std::string) + heap(tag) + child.memoryUsage();
+	}
+	return bytes;
+}
+
 std::string const& Timing::color() const { return color_; }
 
 void Timing::setColor(std::string const& color) { color_ = color; }
@@ -297,6 +798,279 @@ void Timing::printNanoseconds(std::string const& name, bool random_colors, bool
 	                                        group_colors_level, precision);
 }
 
+void Timing::printFramesSeconds(std::string const& name, int precision) const
+{
+	printFrames<std::chrono::seconds::period>(name, precision);
+}
+
+void Timing::printFramesMilliseconds(std::string const& name, int precision) const
+{
+	printFrames<std::chrono::milliseconds::period>(name, precision);
+}
+
+void Timing::printFramesMicroseconds(std::string const& name, int precision) const
+{
+	printFrames<std::chrono::microseconds::period>(name, precision);
+}
+
+void Timing::printFramesNanoseconds(std::string const& name, int precision) const
+{
+	printFrames<std::chrono::nanoseconds::period>(name, precision);
+}
+
+void Timing::printSlowestSamplesSeconds(std::string const& name, int precision) const
+{
+	printSlowestSamples<std::chrono::seconds::period>(name, precision);
+}
+
+void Timing::printSlowestSamplesMilliseconds(std::string const& name,
+                                             int                precision) const
+{
+	printSlowestSamples<std::chrono::milliseconds::period>(name, precision);
+}
+
+void Timing::printSlowestSamplesMicroseconds(std::string const& name,
+                                             int                precision) const
+{
+	printSlowestSamples<std::chrono::microseconds::period>(name, precision);
+}
+
+void Timing::printSlowestSamplesNanoseconds(std::string const& name,
+                                            int                precision) const
+{
+	printSlowestSamples<std::chrono::nanoseconds::period>(name, precision);
+}
+
+void Timing::printThreadsSeconds(std::string const& name, int precision) const
+{
+	printThreads<std::chrono::seconds::period>(name, precision);
+}
+
+void Timing::printThreadsMilliseconds(std::string const& name, int precision) const
+{
+	printThreads<std::chrono::milliseconds::period>(name, precision);
+}
+
+void Timing::printThreadsMicroseconds(std::string const& name, int precision) const
+{
+	printThreads<std::chrono::microseconds::period>(name, precision);
+}
+
+void Timing::printThreadsNanoseconds(std::string const& name, int precision) const
+{
+	printThreads<std::chrono::nanoseconds::period>(name, precision);
+}
+
+void Timing::printSizesSeconds(std::string const& name, int precision) const
+{
+	printSizes<std::chrono::seconds::period>(name, precision);
+}
+
+void Timing::printSizesMilliseconds(std::string const& name, int precision) const
+{
+	printSizes<std::chrono::milliseconds::period>(name, precision);
+}
+
+void Timing::printSizesMicroseconds(std::string const& name, int precision) const
+{
+	printSizes<std::chrono::microseconds::period>(name, precision);
+}
+
+void Timing::printSizesNanoseconds(std::string const& name, int precision) const
+{
+	printSizes<std::chrono::nanoseconds::period>(name, precision);
+}
+
+void Timing::writeOpenMetrics(std::ostream& out, std::string const& prefix) const
+{
+	std::vector<NodeStats> nodes;
+	nodeStatsRecurs(nodes, "");
+
+	auto escape = [](std::string const& str) {
+		std::string res;
+		res.reserve(str.size());
+		for (char c : str) {
+			switch (c) {
+				case '\\': res += "\\\\"; break;
+				case '"': res += "\\\""; break;
+				case '\n': res += "\\n"; break;
+				default: res += c;
+			}
+		}
+		return res;
+	};
+
+	std::vector<std::string> labels;
+	labels.reserve(nodes.size());
+	for (auto const& n : nodes) {
+		labels.push_back("{path=\"" + escape(n.path) + "\"}");
+	}
+
+	auto family = [&](std::string const& name, char const* type, char const* unit,
+	                  char const* help, char const* suffix, auto value) {
+		out << "# TYPE " << prefix << name << ' ' << type << '\n';
+		if ('\0' != unit[0]) {
+			out << "# UNIT " << prefix << name << ' ' << unit << '\n';
+		}
+		out << "# HELP " << prefix << name << ' ' << help << '\n';
+		for (std::size_t i{}; nodes.size() > i; ++i) {
+			double v = value(nodes[i]);
+			out << prefix << name << suffix << labels[i] << ' ';
+			if (std::isnan(v)) {
+				out << "NaN";
+			} else {
+				out << v;
+			}
+			out << '\n';
+		}
+	};
+
+	auto flags = out.flags();
+	auto prec  = out.precision(std::numeric_limits<double>::max_digits10);
+
+	family("_samples", "counter", "", "Number of samples.", "_total",
+	       [](NodeStats const& n) { return n.timer.numSamples(); });
+	family("_seconds", "counter", "seconds", "Total time of all samples.", "_total",
+	       [](NodeStats const& n) { return n.timer.totalSeconds(); });
+	family("_last_seconds", "gauge", "seconds", "Duration of the last sample.", "",
+	       [](NodeStats const& n) { return n.timer.lastSeconds(); });
+	family("_mean_seconds", "gauge", "seconds", "Mean duration of the samples.", "",
+	       [](NodeStats const& n) { return n.timer.meanSeconds(); });
+	family("_stddev_seconds", "gauge", "seconds",
+	       "Population standard deviation of the samples.", "",
+	       [](NodeStats const& n) { return n.timer.stdSeconds(); });
+	family("_min_seconds", "gauge", "seconds", "Shortest sample.", "",
+	       [](NodeStats const& n) { return n.timer.minSeconds(); });
+	family("_max_seconds", "gauge", "seconds", "Longest sample.", "",
+	       [](NodeStats const& n) { return n.timer.maxSeconds(); });
+	family("_running_threads", "gauge", "", "Number of threads currently running.", "",
+	       [](NodeStats const& n) { return n.running_threads; });
+	family("_max_concurrent_threads", "gauge", "",
+	       "Maximum number of threads that have run concurrently.", "",
+	       [](NodeStats const& n) { return n.max_concurrent_threads; });
+	family("_deadline_misses", "counter", "", "Number of samples exceeding the budget.",
+	       "_total", [](NodeStats const& n) { return n.deadline_misses; });
+
+	out << "# EOF\n";
+
+	out.precision(prec);
+	out.flags(flags);
+}
+
+std::string Timing::openMetrics(std::string const& prefix) const
+{
+	std::ostringstream ss;
+	writeOpenMetrics(ss, prefix);
+	return ss.str();
+}
+
+bool Timing::readOpenMetrics(std::istream& in, std::string const& prefix)
+{
+	struct Values {
+		double samples = 0, total = 0, last = 0, mean = 0, stddev = 0;
+		double min = std::numeric_limits<double>::quiet_NaN();
+		double max = std::numeric_limits<double>::quiet_NaN();
+		double max_concurrent_threads = 0;
+	};
+
+	std::map<std::string, double Values::*> const families{
+	    {prefix + "_samples_total", &Values::samples},
+	    {prefix + "_seconds_total", &Values::total},
+	    {prefix + "_last_seconds", &Values::last},
+	    {prefix + "_mean_seconds", &Values::mean},
+	    {prefix + "_stddev_seconds", &Values::stddev},
+	    {prefix + "_min_seconds", &Values::min},
+	    {prefix + "_max_seconds", &Values::max},
+	    {prefix + "_max_concurrent_threads", &Values::max_concurrent_threads}};
+
+	// Keeps the order the nodes are written in
+	std::vector<std::pair<std::string, Values>> nodes;
+	std::map<std::string, std::size_t>          index;
+
+	for (std::string line; std::getline(in, line);) {
+		if (line.empty() || '#' == line[0]) {
+			continue;
+		}
+
+		auto label = line.find("{path=\"");
+		if (std::string::npos == label) {
+			continue;
+		}
+
+		auto family = families.find(line.substr(0, label));
+		if (std::end(families) == family) {
+			continue;
+		}
+
+		std::string path;
+		std::size_t i = label + 7;
+		for (; line.size() > i && '"' != line[i]; ++i) {
+			if ('\\' == line[i] && line.size() > i + 1) {
+				++i;
+				path += 'n' == line[i] ? '\n' : line[i];
+			} else {
+				path += line[i];
+			}
+		}
+
+		auto value_pos = line.find(' ', i);
+		if (std::string::npos == value_pos) {
+			continue;
+		}
+		double value = std::strtod(line.c_str() + value_pos + 1, nullptr);
+
+		auto [it, added] = index.try_emplace(path, nodes.size());
+		if (added) {
+			nodes.emplace_back(path, Values{});
+		}
+		nodes[it->second].second.*(family->second) = value;
+	}
+
+	if (nodes.empty()) {
+		return false;
+	}
+
+	std::lock_guard lock(mutex_);
+
+	clearChildren();
+	if (journal_) {
+		// The tag may change
+		journal_->forget(*this);
+	}
+	timer_.reset();
+	work_.clear();
+	work_time_.clear();
+
+	tag_ = nodes.front().first.substr(0, nodes.front().first.find('/'));
+
+	for (auto const& [path, v] : nodes) {
+		Timing* node = this;
+		for (std::size_t first = path.find('/'); std::string::npos != first;) {
+			auto last = path.find('/', first + 1);
+			node      = &node->child(path.substr(first + 1, last - first - 1));
+			first     = last;
+		}
+
+		using Duration  = std::chrono::high_resolution_clock::duration;
+		auto toDuration = [](double seconds) {
+			return std::chrono::round<Duration>(std::chrono::duration<double>(seconds));
+		};
+
+		Timer& t             = node->timer_;
+		t.samples_           = static_cast<int>(v.samples);
+		t.total_             = toDuration(v.total);
+		t.last_              = toDuration(v.last);
+		t.mean_              = std::chrono::duration<double>(v.mean);
+		t.sum_squares_diffs_ = v.stddev * v.stddev * v.samples;
+		t.min_               = std::isnan(v.min) ? Duration::max() : toDuration(v.min);
+		t.max_               = std::isnan(v.max) ? Duration::min() : toDuration(v.max);
+
+		node->max_concurrent_threads_ = static_cast<std::size_t>(v.max_concurrent_threads);
+	}
+
+	return true;
+}
+
 //
 // Private functions
 //
@@ -386,16 +1160,378 @@ void Timing::unlockParents()
 	}
 }
 
-Timing* Timing::findDeepest(std::thread::id id)
+Timing& Timing::child(std::string const& tag)
 {
-	for (auto& [_, child] : children_) {
+	if (auto it = children_.find(tag); std::end(children_) != it) {
+		return it->second;
+	}
+
+	bool overflow =
+	    limits_ && otherTag() != tag &&
+	    (limits_->max_children <= children_.size() - children_.count(otherTag()) ||
+	     !reserve(childBytes(tag)));
+	if (overflow) {
+		++limits_->overflows;
+		if (auto it = children_.find(otherTag()); std::end(children_) != it) {
+			return it->second;
+		}
+	}
+
+	std::string const& t = overflow ? otherTag() : tag;
+
+	auto& c    = children_.try_emplace(t, t).first->second;
+	c.parent_  = this;
+	c.journal_ = journal_;
+	c.limits_  = limits_;
+	if (limits_ && otherTag() == t) {
+		// Always allowed, so it is charged without checking the limits
+		++limits_->nodes;
+		limits_->bytes += childBytes(t);
+	}
+	return c;
+}
+
+bool Timing::reserve(std::size_t bytes)
+{
+	// Nodes are added concurrently under different parents, so the limits are checked
+	// against what was reserved and the reservation is rolled back if it does not fit
+	if (limits_->max_nodes <= limits_->nodes.fetch_add(1)) {
+		--limits_->nodes;
+		return false;
+	}
+	if (limits_->max_bytes < limits_->bytes.fetch_add(bytes) + bytes) {
+		limits_->bytes -= bytes;
+		--limits_->nodes;
+		return false;
+	}
+	return true;
+}
+
+std::size_t Timing::treeBytes() const
+{
+	std::lock_guard lock(mutex_);
+	std::size_t     bytes{};
+	for (auto const& [tag, child] : children_) {
+		bytes += childBytes(tag) + child.treeBytes();
+	}
+	return bytes;
+}
+
+std::size_t Timing::childBytes(std::string const& tag)
+{
+	// The tag is stored in both the key and the child
+	return 4 * sizeof(void*) + sizeof(decltype(children_)::value_type) +
+	       2 * stringHeap(tag.size());
+}
+
+bool Timing::fold(Timing& leaf, std::size_t& nodes)
+{
+	std::lock_guard lock(mutex_);
+
+	auto it = children_.find(leaf.tag_);
+	if (std::end(children_) == it || &it->second != &leaf) {
+		return false;
+	}
+
+	{
+		std::lock_guard leaf_lock(leaf.mutex_);
+		if (!leaf.children_.empty() || !leaf.thread_.empty()) {
+			return false;
+		}
+	}
+
+	if (0 < children_.count(otherTag())) {
+		--nodes;
+	}
+	auto& other = child(otherTag());
+
+	{
+		std::scoped_lock folding(leaf.mutex_, other.mutex_);
+		other.timer_ += leaf.timer_;
+		for (auto const& [name, amount] : leaf.work_) {
+			other.work_[name] += amount;
+		}
+		for (auto const& [name, time] : leaf.work_time_) {
+			other.work_time_[name] += time;
+		}
+		if (other.sizes_.size() < leaf.sizes_.size()) {
+			other.sizes_.resize(leaf.sizes_.size());
+		}
+		for (std::size_t i{}; leaf.sizes_.size() > i; ++i) {
+			other.sizes_[i].timer += leaf.sizes_[i].timer;
+			other.sizes_[i].size_sum += leaf.sizes_[i].size_sum;
+		}
+		other.deadline_misses_ += leaf.deadline_misses_;
+		other.max_concurrent_threads_ =
+		    std::max(other.max_concurrent_threads_, leaf.max_concurrent_threads_);
+	}
+
+	if (limits_) {
+		--limits_->nodes;
+		limits_->bytes -= std::min(limits_->bytes.load(), childBytes(leaf.tag_));
+	}
+
+	// Before the memory can be reused by a new node
+	if (leaf.journal_) {
+		leaf.journal_->forget(leaf);
+	}
+
+	children_.erase(it);
+	return true;
+}
+
+void Timing::foldableRecurs(std::vector<std::pair<double, Timing*>>& leaves)
+{
+	std::lock_guard lock(mutex_);
+	for (auto& [tag, child] : children_) {
+		bool leaf;
+		{
+			std::lock_guard child_lock(child.mutex_);
+			leaf = child.children_.empty() && child.thread_.empty();
+			if (leaf && otherTag() != tag) {
+				leaves.emplace_back(child.timer_.totalSeconds(), &child);
+			}
+		}
+		if (!leaf) {
+			child.foldableRecurs(leaves);
+		}
+	}
+}
+
+void Timing::clearChildren()
+{
+	for (auto& [tag, child] : children_) {
 		std::lock_guard lock(child.mutex_);
-		if (0 < child.thread_.count(id)) {
-			return child.findDeepest(id);
+		child.clearChildren();
+
+		if (limits_) {
+			--limits_->nodes;
+			limits_->bytes -= std::min(limits_->bytes.load(), childBytes(tag));
+		}
+
+		// Before the memory can be reused by a new node
+		if (child.journal_) {
+			child.journal_->forget(child);
 		}
 	}
+	children_.clear();
+}
+
+void Timing::setLimitsRecurs(std::shared_ptr<Limits> const& limits)
+{
+	std::lock_guard lock(mutex_);
+	limits_ = limits;
+	for (auto& [_, child] : children_) {
+		child.setLimitsRecurs(limits);
+	}
+}
+
+std::vector<std::string> Timing::path() const
+{
+	std::vector<std::string> res;
+	for (auto p = this; nullptr != p; p = p->parent_) {
+		res.push_back(p->tag_);
+	}
+	std::reverse(std::begin(res), std::end(res));
+	return res;
+}
+
+std::vector<Timing::Frame> Timing::sortedSlowestFrames() const
+{
+	if (!frames_) {
+		return {};
+	}
+
+	auto res = frames_->slowest;
+	std::sort(std::begin(res), std::end(res),
+	          [](Frame const& a, Frame const& b) { return a.period > b.period; });
+	return res;
+}
+
+std::wstring Timing::timestamp(std::chrono::system_clock::time_point time)
+{
+	auto t  = std::chrono::system_clock::to_time_t(time);
+	auto us =
+	    std::chrono::duration_cast<std::chrono::microseconds>(
+	        time - std::chrono::system_clock::from_time_t(t))
+	        .count();
+
+	std::tm tm{};
+	localtime_r(&t, &tm);
+
+	std::wstringstream ss;
+	ss << std::put_time(&tm, L"%F %T") << L'.' << std::setfill(L'0') << std::setw(6) << us;
+	return ss.str();
+}
+
+Timing* Timing::findDeepest(std::thread::id id)
+{
+	Timing* running = nullptr;
+	{
+		std::lock_guard lock(mutex_);
+		for (auto& [_, child] : children_) {
+			std::lock_guard child_lock(child.mutex_);
+			if (0 < child.thread_.count(id)) {
+				running = &child;
+				break;
+			}
+		}
+	}
+
+	return nullptr == running ? this : running->findDeepest(id);
+}
+
+bool Timing::stopImpl(std::initializer_list<std::pair<std::string const, double>> work,
+                      std::size_t const*                                          size)
+{
+	auto time = std::chrono::high_resolution_clock::now();
+	auto id   = std::this_thread::get_id();
+
+	{
+		std::lock_guard lock(mutex_);
+		if (0 == thread_.count(id)) {
+			return false;
+		}
+	}
+
+	Timing* current = findDeepest(id);
+
+	current->mutex_.lock();
+
+	auto& st = current->thread_[id];
+	auto  et = st.extra_time;
+	// `st` is erased below, before the start is needed for the last time
+	auto const start   = st.start + et;
+	auto const elapsed = time - start;
+	current->timer_.addSample(start, time);
+	if (current->series_) {
+		current->series_->add(start, time);
+	}
+	if (auto& th = current->threads_; th && 0 < th->running) {
+		th->timers[id].addSample(start, time);
+		th->section_threads.insert(id);
+		th->section_start = std::min(th->section_start, start);
+		th->section_busy += elapsed;
+		if (0 == --th->running) {
+			auto wall = time - th->section_start;
+			th->wall.addSample(th->section_start, time);
+			th->busy += th->section_busy;
+			th->capacity += wall * th->section_threads.size();
+			th->section_start = decltype(th->section_start)::max();
+			th->section_busy  = std::chrono::high_resolution_clock::duration::zero();
+			th->section_threads.clear();
+		}
+	}
+	current->thread_.erase(id);
+	for (auto const& [name, amount] : work) {
+		current->work_[name] += amount;
+		current->work_time_[name] += elapsed;
+	}
+	if (nullptr != size) {
+		current->addSizeSample(*size, start, time);
+	}
+
+	if (auto& sl = current->slowest_;
+	    sl && (sl->samples.size() < sl->num || sl->samples.front().duration < elapsed)) {
+		auto cmp = [](Sample const& a, Sample const& b) { return a.duration > b.duration; };
+		if (sl->samples.size() == sl->num) {
+			std::pop_heap(std::begin(sl->samples), std::end(sl->samples), cmp);
+			sl->samples.pop_back();
+		}
+		auto& s    = sl->samples.emplace_back();
+		s.duration = elapsed;
+		s.start    = std::chrono::system_clock::now() -
+		          std::chrono::duration_cast<std::chrono::system_clock::duration>(
+		              std::chrono::high_resolution_clock::now() - start);
+		s.thread = id;
+		s.path   = current->path();
+		std::push_heap(std::begin(sl->samples), std::end(sl->samples), cmp);
+	}
+
+	std::shared_ptr<BudgetCallback const> budget_callback;
+	bool                                  budget_deferred{};
+	if (current->budget_ < elapsed) {
+		++current->deadline_misses_;
+		budget_callback = current->budget_callback_;
+		budget_deferred = current->budget_deferred_;
+	}
+
+	Timing* parent  = current->parent_;
+	auto    journal = current->journal_;
+
+	current->mutex_.unlock();
+
+	scope_ = parent;
+	UFOTIME_PROBE4(timing__stop, current, parent, current->tag_.c_str(),
+	               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+	if (journal) {
+		journal->stop(*current, time);
+	}
+
+	if (budget_callback) {
+		// Done before updating the parent so the callback is not part of its time
+		if (budget_deferred) {
+			// Dropped if the budget is replaced or the timing destroyed before it runs, as
+			// the callback may refer to what is destroyed with the timing
+			BudgetDispatcher::instance().post(
+			    [f = std::weak_ptr(budget_callback), elapsed, path = current->path()]() {
+				    if (auto callback = f.lock()) {
+					    (*callback)(elapsed, path);
+				    }
+			    });
+		} else {
+			(*budget_callback)(elapsed, current->path());
+		}
+	}
+
+	if (nullptr != parent) {
+		parent->mutex_.lock();
+		auto& st = parent->thread_[id];
+		parent->mutex_.unlock();
+		time -= st.extra_time + et;
+		st.extra_time = std::chrono::high_resolution_clock::now() - time;
+	}
+
+	return true;
+}
+
+std::size_t Timing::sizeIndex(std::size_t size)
+{
+	std::size_t i{};
+	for (; 0 != size; size >>= 1) {
+		++i;
+	}
+	return i;
+}
+
+void Timing::addSizeSample(
+    std::size_t size, std::chrono::time_point<std::chrono::high_resolution_clock> start,
+    std::chrono::time_point<std::chrono::high_resolution_clock> stop)
+{
+	auto i = sizeIndex(size);
+	if (sizes_.size() <= i) {
+		sizes_.resize(i + 1);
+	}
+	sizes_[i].timer.addSample(start, stop);
+	sizes_[i].size_sum += static_cast<double>(size);
+}
 
-	return this;
+std::vector<Timing::SizeBucket> Timing::sizeBucketsImpl() const
+{
+	std::vector<SizeBucket> buckets;
+	for (std::size_t i{}; sizes_.size() > i; ++i) {
+		auto const& s = sizes_[i];
+		if (0 == s.timer.numSamples()) {
+			continue;
+		}
+		auto& b     = buckets.emplace_back();
+		b.min_size  = 0 == i ? 0 : std::size_t(1) << (i - 1);
+		b.max_size  = 0 == i ? 0 : b.min_size + (b.min_size - 1);
+		b.mean_size = s.size_sum / s.timer.numSamples();
+		b.timer     = s.timer;
+	}
+	return buckets;
 }
 
 std::size_t Timing::stop(std::chrono::time_point<std::chrono::high_resolution_clock> time,
@@ -506,6 +1642,24 @@ void Timing::mergeImpl(Timing&& source)
 	// TODO: Implement
 }
 
+void Timing::nodeStatsRecurs(std::vector<NodeStats>& data, std::string const& path) const
+{
+	std::lock_guard lock(mutex_);
+
+	auto& n                  = data.emplace_back();
+	n.path                   = path.empty() ? tag_ : path + '/' + tag_;
+	n.timer                  = timer_;
+	n.running_threads        = numRunningThreads();
+	n.max_concurrent_threads = max_concurrent_threads_;
+	n.deadline_misses        = deadline_misses_;
+
+	// `n` is invalidated when the children are added
+	std::string p = n.path;
+	for (auto const& [_, child] : children_) {
+		child.nodeStatsRecurs(data, p);
+	}
+}
+
 std::vector<Timing::TimingNL> Timing::timings() const
 {
 	std::vector<TimingNL> data;
@@ -541,31 +1695,31 @@ int Timing::maxTagLength(std::vector<TimingNL> const& timers) const
 }
 
 void Timing::addTags(std::vector<std::pair<std::wstring, std::wstring>>& data,
-                     std::vector<TimingNL> const&                        timers) const
+                     std::vector<std::pair<int, std::string>> const&     tags)
 {
 	// TODO: Optimized
 
 	std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
 
-	for (std::size_t i{}; timers.size() > i; ++i) {
+	for (std::size_t i{}; tags.size() > i; ++i) {
 		std::wstring prefix = L" ";
 		// TODO: std::wstring tag_postfix = timers[i].timing->has_run_concurrent_ ? L"² " : L"
 		// ";
 		std::wstring tag_postfix = L" ";
 
-		if (0 == timers[i].level) {
+		if (0 == tags[i].first) {
 			data.emplace_back(prefix,
-			                  converter.from_bytes(timers[i].timing->tag()) + tag_postfix);
+			                  converter.from_bytes(tags[i].second) + tag_postfix);
 			continue;
 		}
 
-		for (int level{}; timers[i].level - 1 > level; ++level) {
+		for (int level{}; tags[i].first - 1 > level; ++level) {
 			bool found = false;
-			for (std::size_t j = i + 1; timers.size() > j; ++j) {
-				if (level == timers[j].level) {
+			for (std::size_t j = i + 1; tags.size() > j; ++j) {
+				if (level == tags[j].first) {
 					found = true;
 					break;
-				} else if (level > timers[j].level) {
+				} else if (level > tags[j].first) {
 					break;
 				}
 			}
@@ -577,11 +1731,11 @@ void Timing::addTags(std::vector<std::pair<std::wstring, std::wstring>>& data,
 		}
 
 		bool found = false;
-		for (std::size_t j = i + 1; timers.size() > j; ++j) {
-			if (timers[i].level == timers[j].level) {
+		for (std::size_t j = i + 1; tags.size() > j; ++j) {
+			if (tags[i].first == tags[j].first) {
 				found = true;
 				break;
-			} else if (timers[i].level > timers[j].level) {
+			} else if (tags[i].first > tags[j].first) {
 				break;
 			}
 		}
@@ -592,8 +1746,301 @@ void Timing::addTags(std::vector<std::pair<std::wstring, std::wstring>>& data,
 		}
 
 		data.emplace_back(prefix,
-		                  converter.from_bytes(timers[i].timing->tag()) + tag_postfix);
+		                  converter.from_bytes(tags[i].second) + tag_postfix);
+	}
+}
+
+std::vector<std::pair<std::wstring, std::wstring>> Timing::tags(
+    std::vector<TimingNL> const& timers) const
+{
+	std::vector<std::pair<int, std::string>> t;
+	t.reserve(timers.size());
+	for (auto const& e : timers) {
+		t.emplace_back(e.level, e.timing->tag());
+	}
+
+	std::vector<std::pair<std::wstring, std::wstring>> component{{L" Component ", L""}};
+	addTags(component, t);
+	return component;
+}
+
+std::vector<std::string> Timing::colors(std::vector<TimingNL> const& timers,
+                                        bool random_colors, bool bold,
+                                        int group_colors_level) const
+{
+	static constexpr std::array const RC{redColor(),  greenColor(),   yellowColor(),
+	                                     blueColor(), magentaColor(), cyanColor(),
+	                                     whiteColor()};
+
+	std::vector<std::string> data;
+	data.reserve(timers.size());
+
+	int rng_color = 0;
+	for (auto const& t : timers) {
+		rng_color += t.level <= group_colors_level;
+		std::string color = bold ? "\033[1m" : "";
+		color += random_colors ? RC[rng_color % RC.size()] : t.timing->color().c_str();
+		data.push_back(std::move(color));
+	}
+
+	return data;
+}
+
+std::wstring Timing::header(std::string const& name, std::wstring const& unit)
+{
+	std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
+	return L" " + (name.empty() ? L"Timings" : converter.from_bytes(name) + L" timings") +
+	       L" in " + unit + L" ";
+}
+
+void Timing::printTable(
+    std::wstring const&                                       header_left,
+    std::vector<std::pair<std::wstring, std::wstring>> const& component,
+    std::vector<std::string> const&                           colors,
+    std::vector<std::vector<std::wstring>> const& columns, bool info)
+{
+	std::ostringstream out;
+	printTable(out, header_left, component, colors, columns, info);
+	std::fputs(out.str().c_str(), stdout);
+}
+
+void Timing::printTable(
+    std::ostream& out, std::wstring const& header_left,
+    std::vector<std::pair<std::wstring, std::wstring>> const& component,
+    std::vector<std::string> const&                           colors,
+    std::vector<std::vector<std::wstring>> const& columns, bool info)
+{
+	std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
+
+	std::wstring header_right = L" UFO 🛸 ";
+
+	// Left + right (the UFO is two columns wide) + seperator
+	std::size_t header_length = header_left.length() + header_right.length() + 1 + 1;
+
+	std::size_t component_length{};
+	for (auto const& [prefix, tag] : component) {
+		component_length = std::max(component_length, prefix.length() + tag.length());
+	}
+
+	std::vector<std::size_t> data_length;
+	for (auto const& c : columns) {
+		data_length.push_back(maxLength(c));
+	}
+
+	std::size_t total_length = std::accumulate(std::begin(data_length),
+	                                           std::end(data_length), component_length + 1);
+	if (total_length < header_length) {
+		// Widen the last column so the rows fill the header
+		(data_length.empty() ? component_length : data_length.back()) +=
+		    header_length - total_length;
+		total_length = header_length;
+	}
+
+	{
+		// Header
+		std::size_t header_sep_pos = std::max(header_left.length(), total_length / 2);
+
+		auto t_1 = converter.to_bytes(std::wstring(header_sep_pos, L'─'));
+		auto t_2 = converter.to_bytes(std::wstring(total_length - header_sep_pos - 1, L'─'));
+		formatTo(out, "╭%s┬%s╮\n", t_1.c_str(), t_2.c_str());
+		t_1     = converter.to_bytes(header_left);
+		t_2     = converter.to_bytes(header_right);
+		int s_1 = static_cast<int>(header_sep_pos);
+		int s_2 = total_length - header_sep_pos + 1;
+		formatTo(out, "│%-*s│%*s│\n", s_1, t_1.c_str(), s_2, t_2.c_str());
+		if (component_length == header_sep_pos) {
+			t_1 = converter.to_bytes(std::wstring(header_sep_pos, L'─'));
+			t_2 = converter.to_bytes(std::wstring(total_length - header_sep_pos - 1, L'─'));
+			formatTo(out, "├%s┼%s┤\n", t_1.c_str(), t_2.c_str());
+		} else if (component_length < header_sep_pos) {
+			t_1 = converter.to_bytes(std::wstring(component_length, L'─'));
+			t_2 = converter.to_bytes(std::wstring(header_sep_pos - component_length - 1, L'─'));
+			auto t_3 =
+			    converter.to_bytes(std::wstring(total_length - header_sep_pos - 1, L'─'));
+			formatTo(out, "├%s┬%s┴%s┤\n", t_1.c_str(), t_2.c_str(), t_3.c_str());
+		} else {
+			t_1 = converter.to_bytes(std::wstring(header_sep_pos, L'─'));
+			t_2 = converter.to_bytes(std::wstring(component_length - header_sep_pos - 1, L'─'));
+			auto t_3 =
+			    converter.to_bytes(std::wstring(total_length - component_length - 1, L'─'));
+			formatTo(out, "├%s┴%s┬%s┤\n", t_1.c_str(), t_2.c_str(), t_3.c_str());
+		}
+	}
+
+	{
+		// Labels
+		auto [left_pad, right_pad] = centeringPadding(component[0].first, component_length);
+		formatTo(out, "│%*s%s%*s│", left_pad, "",
+		            converter.to_bytes(component[0].first).c_str(), right_pad, "");
+		for (std::size_t i{0}; columns.size() != i; ++i) {
+			auto [left_pad, right_pad] = centeringPadding(columns[i][0], data_length[i]);
+			formatTo(out, "%*s%s%*s", left_pad, "", converter.to_bytes(columns[i][0]).c_str(),
+			            right_pad, "");
+		}
+		formatTo(out, "│\n");
+		auto t_1 = converter.to_bytes(std::wstring(component_length, L'─'));
+		auto t_2 =
+		    converter.to_bytes(std::wstring(total_length - component_length - 1, L'─'));
+		formatTo(out, "├%s┼%s┤\n", t_1.c_str(), t_2.c_str());
+	}
+
+	{
+		// Data
+		for (std::size_t i{1}; component.size() > i; ++i) {
+			std::string const& color = colors[i - 1];
+
+			formatTo(out, "│");
+			{
+				// Component
+				if (1 == i) {
+					auto [left_pad, right_pad] =
+					    centeringPadding(component[i].second, component_length);
+					formatTo(out, "%*s%s%s%*s", left_pad, "", color.c_str(),
+					            converter.to_bytes(component[i].second).c_str(), right_pad, "");
+				} else {
+					auto prefix = converter.to_bytes(component[i].first);
+					auto tag    = converter.to_bytes(component[i].second);
+					int  s      = component_length - component[i].first.length() -
+					        component[i].second.length();
+					formatTo(out, "%s%s%s%*s", prefix.c_str(), color.c_str(), tag.c_str(), s, "");
+				}
+				formatTo(out, "%s│%s", resetColor(), color.c_str());
+			}
+
+			{
+				// Other data
+				for (std::size_t j{0}; columns.size() > j; ++j) {
+					auto [left_pad, right_pad] = centeringPadding(columns[j][i], data_length[j]);
+					auto cell                  = converter.to_bytes(columns[j][i]);
+					if (L" nan " == columns[j][i]) {
+						// Center aligned
+						formatTo(out, "%*s%s%*s", left_pad, "", cell.c_str(), right_pad, "");
+					} else {
+						// Left aligned
+						formatTo(out, "%s%*s", cell.c_str(), left_pad + right_pad, "");
+					}
+				}
+			}
+
+			// Reset color
+			formatTo(out, "%s│\n", resetColor());
+
+			{
+				// First seperator
+				if (1 == i && component.size() > 2) {
+					auto t_1 = converter.to_bytes(std::wstring(component_length, L'╌'));
+					auto t_2 =
+					    converter.to_bytes(std::wstring(total_length - component_length - 1, L'╌'));
+					formatTo(out, "├%s┼%s┤\n", t_1.c_str(), t_2.c_str());
+				}
+			}
+		}
+	}
+
+	bool running    = false;
+	bool paused     = false;
+	bool concurrent = false;
+	if (info) {
+		// Info
+		for (auto const& c : columns) {
+			for (auto const& s : c) {
+				running = running || std::wstring::npos != s.find(L'¹');
+				paused  = paused || std::wstring::npos != s.find(L'²');
+			}
+		}
+
+		for (auto const& [_, tag] : component) {
+			if (std::wstring::npos != tag.find(L'³')) {
+				concurrent = true;
+				break;
+			}
+		}
+
+		if (running || concurrent) {
+			auto t_1 = converter.to_bytes(std::wstring(component_length, L'─'));
+			auto t_2 =
+			    converter.to_bytes(std::wstring(total_length - component_length - 1, L'─'));
+			formatTo(out, "├%s┴%s┤\n", t_1.c_str(), t_2.c_str());
+			if (running) {
+				std::wstring info = L" ¹ # running threads that are not accounted for ";
+				int          s    = static_cast<int>(total_length - info.length());
+				formatTo(out, "│%s%*s│\n", converter.to_bytes(info).c_str(), s, "");
+			}
+			if (paused) {
+				std::wstring info = L" ² Indicates that the timer is paused ";
+				int          s    = static_cast<int>(total_length - info.length());
+				formatTo(out, "│%s%*s│\n", converter.to_bytes(info).c_str(), s, "");
+			}
+			if (concurrent) {
+				std::wstring info = L" ³ Indicates that the timer has run concurrently ";
+				int          s    = static_cast<int>(total_length - info.length());
+				formatTo(out, "│%s%*s│\n", converter.to_bytes(info).c_str(), s, "");
+			}
+		}
+	}
+
+	{
+		// Footer
+		if (running || concurrent) {
+			auto t = converter.to_bytes(std::wstring(total_length, L'─'));
+			formatTo(out, "╰%s╯\n", t.c_str());
+		} else {
+			auto t_1 = converter.to_bytes(std::wstring(component_length, L'─'));
+			auto t_2 =
+			    converter.to_bytes(std::wstring(total_length - component_length - 1, L'─'));
+			formatTo(out, "╰%s┴%s╯\n", t_1.c_str(), t_2.c_str());
+		}
+	}
+}
+
+void Timing::addComplexity(std::vector<std::vector<std::wstring>>& columns,
+                           std::vector<TimingNL> const& timers, int precision) const
+{
+	bool any = false;
+	for (auto const& t : timers) {
+		any = any || !t.timing->sizes_.empty();
+	}
+
+	if (!any) {
+		return;
+	}
+
+	std::vector<std::wstring> exponent{L" Exponent "};
+	std::vector<std::wstring> complexity{L" Complexity "};
+	for (auto const& t : timers) {
+		auto fit = t.timing->complexity();
+		if (std::isnan(fit.exponent)) {
+			exponent.push_back(L" nan ");
+			complexity.push_back(L" ");
+			continue;
+		}
+
+		std::wstringstream ss;
+		ss << std::fixed << std::setprecision(precision) << L' ' << fit.exponent << L' ';
+		exponent.push_back(ss.str());
+
+		std::string name = complexityName(fit.complexity);
+		complexity.push_back(L" " + std::wstring(std::begin(name), std::end(name)) + L" ");
+	}
+
+	columns.push_back(std::move(exponent));
+	columns.push_back(std::move(complexity));
+}
+
+std::wstring Timing::siPrefixed(double value, int precision)
+{
+	static constexpr std::array<wchar_t const*, 5> const prefix{L"", L"k", L"M", L"G",
+	                                                             L"T"};
+
+	std::size_t i{};
+	for (; prefix.size() - 1 > i && 1000.0 <= std::abs(value); ++i) {
+		value /= 1000.0;
 	}
+
+	std::wstringstream ss;
+	ss << std::fixed << std::setprecision(precision);
+	ss << L' ' << value << prefix[i] << L' ';
+	return ss.str();
 }
 
 void Timing::addNumSamples(std::vector<std::wstring>&   data,
@@ -619,7 +2066,7 @@ void Timing::addNumThreads(std::vector<std::wstring>&   data,
 	}
 }
 
-std::size_t Timing::maxLength(std::vector<std::string> const& data) const
+std::size_t Timing::maxLength(std::vector<std::string> const& data)
 {
 	std::size_t max{};
 	for (std::string const& s : data) {
@@ -628,7 +2075,7 @@ std::size_t Timing::maxLength(std::vector<std::string> const& data) const
 	return max;
 }
 
-std::size_t Timing::maxLength(std::vector<std::wstring> const& data) const
+std::size_t Timing::maxLength(std::vector<std::wstring> const& data)
 {
 	std::size_t max{};
 	for (std::wstring const& s : data) {
@@ -637,20 +2084,46 @@ std::size_t Timing::maxLength(std::vector<std::wstring> const& data) const
 	return max;
 }
 
-std::pair<int, int> Timing::centeringPadding(std::string const& str, int max_width) const
+std::pair<int, int> Timing::centeringPadding(std::string const& str, int max_width)
 {
 	int left_pad  = std::floor((max_width - static_cast<int>(str.length())) / 2.0);
 	int right_pad = max_width - (left_pad + static_cast<int>(str.length()));
 	return {left_pad, right_pad};
 }
 
-std::pair<int, int> Timing::centeringPadding(std::wstring const& str, int max_width) const
+std::pair<int, int> Timing::centeringPadding(std::wstring const& str, int max_width)
 {
 	int left_pad  = std::floor((max_width - static_cast<int>(str.length())) / 2.0);
 	int right_pad = max_width - (left_pad + static_cast<int>(str.length()));
 	return {left_pad, right_pad};
 }
 
+double Timing::imbalanceImpl() const
+{
+	if (!threads_ || threads_->timers.empty()) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	double sum{};
+	double max{};
+	for (auto const& [_, t] : threads_->timers) {
+		sum += t.total();
+		max = std::max(max, t.total());
+	}
+	return max / (sum / threads_->timers.size());
+}
+
+double Timing::parallelEfficiencyImpl() const
+{
+	if (!threads_ ||
+	    std::chrono::high_resolution_clock::duration::zero() >= threads_->capacity) {
+		return std::numeric_limits<double>::quiet_NaN();
+	}
+
+	return std::chrono::duration<double>(threads_->busy) /
+	       std::chrono::duration<double>(threads_->capacity);
+}
+
 int Timing::numSamples() const { return timer_.numSamples(); }
 
 void Timing::updateMaxConcurrent()
@@ -0,0 +1,270 @@
+// UFO
+#include <ufo/time/timing_diff.hpp>
+
+// STL
+#include <algorithm>
+#include <limits>
+
+namespace ufo
+{
+//
+// Node
+//
+
+double TimingDiff::Node::delta() const
+{
+	return candidate.meanSeconds() - baseline.meanSeconds();
+}
+
+double TimingDiff::Node::relative() const
+{
+	return 0 < baseline.numSamples() && 0 < candidate.numSamples()
+	           ? delta() / baseline.meanSeconds()
+	           : std::numeric_limits<double>::quiet_NaN();
+}
+
+//
+// Public functions
+//
+
+TimingDiff::TimingDiff(Timing const& baseline, Timing const& candidate, double alpha,
+                       double min_effect)
+    : alpha_(alpha), min_effect_(min_effect)
+{
+	std::vector<Timing::NodeStats> base;
+	std::vector<Timing::NodeStats> cand;
+	baseline.nodeStatsRecurs(base, "");
+	candidate.nodeStatsRecurs(cand, "");
+
+	// The path below the root, so trees with different root tags can be compared
+	auto components = [](std::string const& path) {
+		std::vector<std::string> res;
+		for (std::size_t first = path.find('/'); std::string::npos != first;) {
+			auto last = path.find('/', first + 1);
+			res.push_back(path.substr(first + 1, last - first - 1));
+			first = last;
+		}
+		return res;
+	};
+
+	auto add = [this](std::string path, std::size_t depth, Timer const& b,
+	                  Timer const& c) -> Node& {
+		auto& n     = nodes_.emplace_back();
+		n.path      = std::move(path);
+		n.level     = 0 == depth ? 0 : static_cast<int>(depth) - 1;
+		n.baseline  = b;
+		n.candidate = c;
+		n.test      = welchTTest(b, c);
+		n.change    = Change::NONE;
+		return n;
+	};
+
+	// Both are in depth-first order with the children sorted by tag, so they can be
+	// merged like two sorted ranges
+	std::size_t i{};
+	std::size_t j{};
+	while (base.size() > i || cand.size() > j) {
+		auto b = base.size() > i ? components(base[i].path) : std::vector<std::string>{};
+		auto c = cand.size() > j ? components(cand[j].path) : std::vector<std::string>{};
+
+		if (cand.size() <= j || (base.size() > i && b < c)) {
+			add(base[i].path, b.size(), base[i].timer, Timer{}).change = Change::REMOVED;
+			++i;
+		} else if (base.size() <= i || c < b) {
+			std::string path = base.empty() ? cand[j].path
+			                                : base.front().path + cand[j].path.substr(
+			                                                          cand[j].path.find('/'));
+			add(path, c.size(), Timer{}, cand[j].timer).change = Change::ADDED;
+			++j;
+		} else {
+			auto& n = add(base[i].path, b.size(), base[i].timer, cand[j].timer);
+			if (alpha_ > n.test.p && min_effect_ <= std::abs(n.relative())) {
+				n.change = 0 < n.delta() ? Change::REGRESSION : Change::IMPROVEMENT;
+			}
+			++i;
+			++j;
+		}
+	}
+}
+
+std::vector<TimingDiff::Node> const& TimingDiff::nodes() const { return nodes_; }
+
+std::vector<TimingDiff::Node> TimingDiff::regressions() const
+{
+	std::vector<Node> res;
+	for (auto const& n : nodes_) {
+		if (Change::REGRESSION == n.change) {
+			res.push_back(n);
+		}
+	}
+	return res;
+}
+
+std::vector<TimingDiff::Node> TimingDiff::improvements() const
+{
+	std::vector<Node> res;
+	for (auto const& n : nodes_) {
+		if (Change::IMPROVEMENT == n.change) {
+			res.push_back(n);
+		}
+	}
+	return res;
+}
+
+std::vector<TimingDiff::Node> TimingDiff::changedTree() const
+{
+	auto depth = [](Node const& n) {
+		return static_cast<std::size_t>(
+		    std::count(std::begin(n.path), std::end(n.path), '/'));
+	};
+
+	// Bottom-up, as the descendants of a node follow it in depth-first order.
+	// `changed[d]` is whether a node at depth `d` below the current one is kept.
+	std::vector<bool> keep(nodes_.size());
+	std::vector<bool> changed;
+	for (auto i = nodes_.size(); 0 < i--;) {
+		auto d = depth(nodes_[i]);
+		changed.resize(std::max(changed.size(), d + 2));
+		keep[i]        = 0 == d || Change::NONE != nodes_[i].change || changed[d + 1];
+		changed[d + 1] = false;
+		changed[d]     = changed[d] || keep[i];
+	}
+
+	std::vector<Node> res;
+	for (std::size_t i{}; nodes_.size() > i; ++i) {
+		if (keep[i]) {
+			res.push_back(nodes_[i]);
+		}
+	}
+	return res;
+}
+
+double TimingDiff::alpha() const { return alpha_; }
+
+double TimingDiff::minEffect() const { return min_effect_; }
+
+void TimingDiff::printSeconds(bool changed_only, int precision) const
+{
+	print<std::chrono::seconds::period>(changed_only, precision);
+}
+
+void TimingDiff::printMilliseconds(bool changed_only, int precision) const
+{
+	print<std::chrono::milliseconds::period>(changed_only, precision);
+}
+
+void TimingDiff::printMicroseconds(bool changed_only, int precision) const
+{
+	print<std::chrono::microseconds::period>(changed_only, precision);
+}
+
+void TimingDiff::printNanoseconds(bool changed_only, int precision) const
+{
+	print<std::chrono::nanoseconds::period>(changed_only, precision);
+}
+
+void TimingDiff::writeJson(std::ostream& out, bool changed_only) const
+{
+	auto number = [&out](double value) -> std::ostream& {
+		return std::isfinite(value) ? out << value : out << "null";
+	};
+
+	auto string = [&out](std::string const& str) -> std::ostream& {
+		out << '"';
+		for (char c : str) {
+			switch (c) {
+				case '"': out << "\\\""; break;
+				case '\\': out << "\\\\"; break;
+				case '\n': out << "\\n"; break;
+				case '\t': out << "\\t"; break;
+				default:
+					if (0x20 > static_cast<unsigned char>(c)) {
+						out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+						    << static_cast<int>(c) << std::dec << std::setfill(' ');
+					} else {
+						out << c;
+					}
+			}
+		}
+		return out << '"';
+	};
+
+	auto timer = [&](Timer const& t) {
+		out << "{\"samples\": " << t.numSamples() << ", \"mean\": ";
+		number(t.meanSeconds()) << ", \"std\": ";
+		number(std::sqrt(t.sampleVarianceSeconds())) << ", \"min\": ";
+		number(t.minSeconds()) << ", \"max\": ";
+		number(t.maxSeconds()) << ", \"total\": ";
+		number(t.totalSeconds()) << '}';
+	};
+
+	auto flags = out.flags();
+	auto prec  = out.precision(std::numeric_limits<double>::digits10);
+
+	out << "{\n  \"alpha\": ";
+	number(alpha_) << ",\n  \"min_effect\": ";
+	number(min_effect_) << ",\n  \"nodes\": [";
+
+	bool first = true;
+	for (auto const& n : nodes_) {
+		if (changed_only && Change::NONE == n.change) {
+			continue;
+		}
+
+		out << (first ? "\n" : ",\n") << "    {\"path\": ";
+		first = false;
+		string(n.path) << ", \"change\": \"" << name(n.change) << "\", \"baseline\": ";
+		timer(n.baseline);
+		out << ", \"candidate\": ";
+		timer(n.candidate);
+		out << ", \"delta\": ";
+		number(n.delta()) << ", \"relative\": ";
+		number(n.relative()) << ", \"t\": ";
+		number(n.test.t) << ", \"df\": ";
+		number(n.test.df) << ", \"p\": ";
+		number(n.test.p) << '}';
+	}
+
+	out << "\n  ]\n}\n";
+
+	out.precision(prec);
+	out.flags(flags);
+}
+
+//
+// Private functions
+//
+
+std::string TimingDiff::color(Change change)
+{
+	switch (change) {
+		case Change::IMPROVEMENT: return Timing::greenColor();
+		case Change::REGRESSION: return Timing::redColor();
+		case Change::ADDED:
+		case Change::REMOVED: return Timing::yellowColor();
+		default: return "";
+	}
+}
+
+std::wstring TimingDiff::symbol(Change change)
+{
+	switch (change) {
+		case Change::IMPROVEMENT: return L"▼";
+		case Change::REGRESSION: return L"▲";
+		case Change::ADDED: return L"+";
+		case Change::REMOVED: return L"-";
+		default: return L" ";
+	}
+}
+
+char const* TimingDiff::name(Change change)
+{
+	switch (change) {
+		case Change::IMPROVEMENT: return "improvement";
+		case Change::REGRESSION: return "regression";
+		case Change::ADDED: return "added";
+		case Change::REMOVED: return "removed";
+		default: return "none";
+	}
+}
+}  // namespace ufo
@@ -0,0 +1,120 @@
+// UFO
+#include <ufo/time/timing_snapshot.hpp>
+
+namespace ufo
+{
+//
+// Public functions
+//
+
+TimingSnapshot::TimingSnapshot(Timing const& timing)
+    : TimingSnapshot(timing, std::chrono::high_resolution_clock::now())
+{
+}
+
+std::string const& TimingSnapshot::tag() const { return tag_; }
+
+std::string const& TimingSnapshot::color() const { return color_; }
+
+Timer const& TimingSnapshot::timer() const { return timer_; }
+
+std::map<std::string, TimingSnapshot> const& TimingSnapshot::children() const
+{
+	return children_;
+}
+
+TimingSnapshot const& TimingSnapshot::operator[](std::string const& tag) const
+{
+	static TimingSnapshot const empty;
+
+	auto it = children_.find(tag);
+	return std::end(children_) == it ? empty : it->second;
+}
+
+std::chrono::time_point<std::chrono::high_resolution_clock> TimingSnapshot::time() const
+{
+	return time_;
+}
+
+std::chrono::time_point<std::chrono::high_resolution_clock> TimingSnapshot::start() const
+{
+	return start_;
+}
+
+TimingSnapshot& TimingSnapshot::operator-=(TimingSnapshot const& rhs)
+{
+	timer_ -= rhs.timer_;
+	start_ = rhs.time_;
+
+	for (auto& [tag, child] : children_) {
+		if (auto it = rhs.children_.find(tag); std::end(rhs.children_) != it) {
+			child -= it->second;
+		} else {
+			child.start_ = rhs.time_;
+		}
+	}
+
+	return *this;
+}
+
+TimingSnapshot operator-(TimingSnapshot lhs, TimingSnapshot const& rhs)
+{
+	lhs -= rhs;
+	return lhs;
+}
+
+void TimingSnapshot::printSeconds(std::string const& name, int precision) const
+{
+	print<std::chrono::seconds::period>(name, precision);
+}
+
+void TimingSnapshot::printMilliseconds(std::string const& name, int precision) const
+{
+	print<std::chrono::milliseconds::period>(name, precision);
+}
+
+void TimingSnapshot::printMicroseconds(std::string const& name, int precision) const
+{
+	print<std::chrono::microseconds::period>(name, precision);
+}
+
+void TimingSnapshot::printNanoseconds(std::string const& name, int precision) const
+{
+	print<std::chrono::nanoseconds::period>(name, precision);
+}
+
+//
+// Private functions
+//
+
+TimingSnapshot::TimingSnapshot(
+    Timing const&                                               timing,
+    std::chrono::time_point<std::chrono::high_resolution_clock> time)
+    : time_(time)
+{
+	std::vector<std::pair<std::string, Timing const*>> children;
+	{
+		std::lock_guard lock(timing.mutex_);
+
+		tag_   = timing.tag_;
+		color_ = timing.color_;
+		timer_ = timing.timer_;
+		for (auto const& [tag, child] : timing.children_) {
+			children.emplace_back(tag, &child);
+		}
+	}
+
+	for (auto const& [tag, child] : children) {
+		children_.emplace(tag, TimingSnapshot(*child, time));
+	}
+}
+
+void TimingSnapshot::rowsRecurs(std::vector<std::pair<int, TimingSnapshot const*>>& rows,
+                                int level) const
+{
+	rows.emplace_back(level, this);
+	for (auto const& [_, child] : children_) {
+		child.rowsRecurs(rows, level + 1);
+	}
+}
+}  // namespace ufo
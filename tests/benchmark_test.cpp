@@ -0,0 +1,90 @@
+// UFO
+#include <ufo/time/benchmark.hpp>
+#include <ufo/time/statistics.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Student's t quantile")
+{
+	REQUIRE(2.228 == Catch::Approx(ufo::studentTQuantile(0.975, 10)).epsilon(1e-3));
+	REQUIRE(-2.228 == Catch::Approx(ufo::studentTQuantile(0.025, 10)).epsilon(1e-3));
+	REQUIRE(0.0 == Catch::Approx(ufo::studentTQuantile(0.5, 3)).margin(1e-6));
+	REQUIRE(0.9 == Catch::Approx(ufo::studentTCdf(ufo::studentTQuantile(0.9, 4.5), 4.5)));
+}
+
+TEST_CASE("Benchmark")
+{
+	using namespace std::chrono_literals;
+
+	ufo::BenchmarkOptions options;
+	options.warmup              = 1ms;
+	options.min_repetition_time = 100us;
+	options.max_time            = 2s;
+	options.relative_error      = 0.05;
+	options.cpu                 = 0;
+
+	ufo::Benchmark benchmark(options);
+
+	std::vector<double> data(1000, 1.0);
+	auto const&         sum = benchmark.run("Sum", [&data] {
+		double s = 0.0;
+		for (auto d : data) {
+			s += d;
+		}
+		ufo::doNotOptimize(s);
+	});
+
+	REQUIRE("Sum" == sum.name);
+	REQUIRE(1 <= sum.iterations);
+	REQUIRE(options.min_repetitions <= sum.repetitions.size());
+	REQUIRE(0.0 < sum.mean);
+	REQUIRE(sum.ci_low <= sum.mean);
+	REQUIRE(sum.mean <= sum.ci_high);
+	REQUIRE(sum.repetitions.size() == sum.timer.numSamples() + sum.numOutliers());
+
+	// The median is of the repetitions that are not outliers
+	std::vector<double> kept;
+	for (auto const& r : sum.repetitions) {
+		if (!r.outlier) {
+			kept.push_back(std::chrono::duration<double>(r.real).count() / sum.iterations);
+		}
+	}
+	std::sort(std::begin(kept), std::end(kept));
+	auto mid = kept.size() / 2;
+	REQUIRE((1 == kept.size() % 2 ? kept[mid] : 0.5 * (kept[mid - 1] + kept[mid])) ==
+	        Catch::Approx(sum.median));
+
+	auto const& sleep = benchmark.run("Sleep", [] { std::this_thread::sleep_for(200us); });
+	REQUIRE(200e-6 <= sleep.median);
+	REQUIRE(sleep.iterations * 200us >= options.min_repetition_time);
+
+	REQUIRE(2 == benchmark.results().size());
+
+	// Without repetitions there is no mean, so the error is infinite and not converged
+	ufo::BenchmarkOptions none = options;
+	none.max_repetitions       = 0;
+	ufo::Benchmark no_repetitions(none);
+	auto const&    empty = no_repetitions.run("Empty", [] {});
+	REQUIRE(empty.repetitions.empty());
+	REQUIRE(std::isinf(empty.relativeError()));
+	REQUIRE(!empty.converged);
+	REQUIRE(std::isinf(ufo::BenchmarkResult{}.relativeError()));
+
+	std::stringstream json;
+	benchmark.writeJson(json);
+	auto str = json.str();
+	REQUIRE(std::string::npos != str.find("\"context\""));
+	REQUIRE(std::string::npos != str.find("\"name\": \"Sum_mean\""));
+	REQUIRE(std::string::npos != str.find("\"run_type\": \"iteration\""));
+	REQUIRE(std::string::npos != str.find("\"time_unit\": \"ns\""));
+}
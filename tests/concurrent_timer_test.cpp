@@ -0,0 +1,57 @@
+// UFO
+#include <ufo/time/concurrent_timer.hpp>
+#include <ufo/time/timer.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ConcurrentTimer")
+{
+	using namespace std::chrono_literals;
+
+	using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+	ufo::ConcurrentTimer concurrent(6);
+	REQUIRE(8 == concurrent.numShards());
+
+	auto sample = [](int thread, int i) {
+		return std::chrono::microseconds(1 + (thread * 7 + i) % 100);
+	};
+
+	std::vector<std::thread> threads;
+	for (int t{}; 8 > t; ++t) {
+		threads.emplace_back([&concurrent, sample, t] {
+			for (int i{}; 10000 > i; ++i) {
+				concurrent.addSample(TimePoint{}, TimePoint{sample(t, i)});
+			}
+		});
+	}
+	for (auto& th : threads) {
+		th.join();
+	}
+
+	ufo::Timer expected;
+	for (int t{}; 8 > t; ++t) {
+		for (int i{}; 10000 > i; ++i) {
+			expected.addSample(TimePoint{}, TimePoint{sample(t, i)});
+		}
+	}
+
+	auto timer = concurrent.timer();
+	REQUIRE(expected.numSamples() == timer.numSamples());
+	REQUIRE(expected.totalMicroseconds() == timer.totalMicroseconds());
+	REQUIRE(expected.minMicroseconds() == timer.minMicroseconds());
+	REQUIRE(expected.maxMicroseconds() == timer.maxMicroseconds());
+	REQUIRE(expected.meanMicroseconds() == Catch::Approx(timer.meanMicroseconds()));
+	REQUIRE(expected.sampleVarianceMicroseconds() ==
+	        Catch::Approx(timer.sampleVarianceMicroseconds()));
+
+	concurrent.reset();
+	REQUIRE(0 == concurrent.timer().numSamples());
+}
@@ -0,0 +1,99 @@
+// UFO
+#include <ufo/time/dashboard.hpp>
+#include <ufo/time/timing.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// The cells of the row of `tag` in the last table drawn to `out`, without the colors
+std::vector<std::string> row(std::string const& out, std::string const& tag)
+{
+	auto table = out.substr(out.rfind("\033[H"));
+	auto begin = table.find(" " + tag + " ");
+	if (std::string::npos == begin) {
+		return {};
+	}
+	auto line = table.substr(begin, table.find('\n', begin) - begin);
+
+	// Remove the color escape sequences and the borders
+	std::string plain;
+	for (std::size_t i{}; line.size() > i; ++i) {
+		if ('\033' == line[i]) {
+			i = line.find('m', i);
+		} else if (0 == line.compare(i, 3, "│")) {
+			plain += ' ';
+			i += 2;
+		} else {
+			plain += line[i];
+		}
+	}
+
+	std::vector<std::string> cells;
+	std::istringstream       ss(plain);
+	for (std::string cell; ss >> cell;) {
+		cells.push_back(cell);
+	}
+	return cells;
+}
+}  // namespace
+
+TEST_CASE("Dashboard")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Timing timing("Frame");
+
+	// Samples of known length, so the shares and means of an interval are exact
+	auto frame = [&timing](auto update, auto render) {
+		auto t = std::chrono::high_resolution_clock::now();
+		timing["Update"].addSample(t, t + update);
+		timing["Render"].addSample(t + update, t + update + render);
+		timing.addSample(t, t + 10ms);
+	};
+
+	std::ostringstream out;
+	ufo::Dashboard     dashboard(timing, out);
+	REQUIRE_FALSE(dashboard.showing());
+
+	frame(1ms, 2ms);
+	dashboard.drawMilliseconds();
+	// Hottest first
+	REQUIRE(out.str().find(" Render ") < out.str().find(" Update "));
+
+	frame(6ms, 3ms);
+	frame(6ms, 3ms);
+	dashboard.drawMilliseconds();
+	auto const& s = out.str();
+	// Only the interval counts for the order, not the totals
+	REQUIRE(s.rfind(" Update ") < s.rfind(" Render "));
+
+	// Tag, samples/s, ms/s, frame %, mean, total, samples
+	auto update = row(s, "Update");
+	auto render = row(s, "Render");
+	REQUIRE(7 == update.size());
+	REQUIRE(7 == render.size());
+	// Both had two samples in the same interval
+	REQUIRE(update[1] == render[1]);
+	REQUIRE(2.0 < std::stod(update[2]) / std::stod(render[2]) * 1.001);
+	REQUIRE(2.0 > std::stod(update[2]) / std::stod(render[2]) * 0.999);
+	REQUIRE("60.0000" == update[3]);
+	REQUIRE("30.0000" == render[3]);
+	REQUIRE("6.0000" == update[4]);
+	REQUIRE("3.0000" == render[4]);
+	REQUIRE("13.0000" == update[5]);
+	REQUIRE("3" == update[6]);
+
+	dashboard.showMilliseconds(1ms);
+	REQUIRE(dashboard.showing());
+	dashboard.stop();
+	REQUIRE_FALSE(dashboard.showing());
+	REQUIRE(std::string::npos != out.str().find("\033[2J"));
+}
@@ -0,0 +1,59 @@
+// UFO
+#include <ufo/time/flat_profile.hpp>
+#include <ufo/time/timing.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+
+TEST_CASE("FlatProfile")
+{
+	using namespace std::chrono_literals;
+
+	using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+	auto add = [](ufo::Timing& t, std::chrono::milliseconds ms, int samples = 1) {
+		for (int i{}; samples > i; ++i) {
+			t.addSample(TimePoint{}, TimePoint{ms});
+		}
+	};
+
+	// "Ray casting" under two parents, and once within itself
+	ufo::Timing t("Total");
+	auto&       mapping = t["Mapping"];
+	auto&       ray     = mapping["Ray casting"];
+	auto&       nested  = ray["Ray casting"];
+	auto&       planner = t["Planner"];
+	auto&       ray_2   = planner["Ray casting"];
+	add(mapping, 100ms);
+	add(ray, 30ms, 2);
+	add(nested, 10ms);
+	add(planner, 50ms);
+	add(ray_2, 20ms);
+
+	ufo::FlatProfile flat(t);
+	REQUIRE(3 == flat.entries().size());
+	REQUIRE(150.0 == Catch::Approx(1000 * flat.total()));
+
+	// Exclusive time of ray casting is (60 - 10) + 10 + 20 = 80
+	auto const* e = flat.find("Ray casting");
+	REQUIRE(nullptr != e);
+	REQUIRE(e == &flat.entries().front());
+	REQUIRE(80.0 == Catch::Approx(1000 * e->exclusive));
+	// The nested occurrence is not counted twice
+	REQUIRE(80.0 == Catch::Approx(e->inclusive.totalMilliseconds()));
+	REQUIRE(3 == e->inclusive.numSamples());
+	REQUIRE(4 == e->calls);
+
+	REQUIRE(2 == e->parents.size());
+	REQUIRE("Mapping" == e->parents[0].first);
+	REQUIRE(60.0 == Catch::Approx(1000 * e->parents[0].second));
+	REQUIRE("Planner" == e->parents[1].first);
+
+	REQUIRE(40.0 == Catch::Approx(1000 * flat.find("Mapping")->exclusive));
+	REQUIRE("Total" == flat.find("Mapping")->parents[0].first);
+	REQUIRE(nullptr == flat.find("Total"));
+}
@@ -0,0 +1,69 @@
+// UFO
+#include <ufo/time/handoff.hpp>
+#include <ufo/time/timing.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+TEST_CASE("Handoff")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Timing timing("Pipeline");
+
+	std::mutex               m;
+	std::condition_variable  cv;
+	std::queue<ufo::Handoff> queue;
+
+	std::thread consumer([&] {
+		for (int i{}; 3 > i; ++i) {
+			std::unique_lock lock(m);
+			cv.wait(lock, [&queue] { return !queue.empty(); });
+			auto h = queue.front();
+			queue.pop();
+			lock.unlock();
+
+			h.lap(timing["Queue wait"]);
+			std::this_thread::sleep_for(2ms);
+			h.lap(timing["Service"]);
+			h.finish(timing["End-to-end"]);
+		}
+	});
+
+	for (int i{}; 3 > i; ++i) {
+		// Stamped by the sensor 1 ms before it reaches us
+		ufo::Handoff h(std::chrono::system_clock::now() - 1ms);
+		std::this_thread::sleep_for(3ms);
+		{
+			std::lock_guard lock(m);
+			queue.push(h);
+		}
+		cv.notify_one();
+	}
+	consumer.join();
+
+	auto wait    = timing["Queue wait"].timer();
+	auto service = timing["Service"].timer();
+	auto total   = timing["End-to-end"].timer();
+	REQUIRE(3 == wait.numSamples());
+	REQUIRE(3 == service.numSamples());
+	REQUIRE(3 == total.numSamples());
+	REQUIRE(4ms <= std::chrono::duration<double>(wait.minSeconds()));
+	REQUIRE(2ms <= std::chrono::duration<double>(service.minSeconds()));
+	REQUIRE(wait.totalSeconds() + service.totalSeconds() <= total.totalSeconds());
+
+	ufo::Timer   t;
+	ufo::Handoff h;
+	h.lap(t).lap(t);
+	h.finish(t);
+	REQUIRE(3 == t.numSamples());
+	REQUIRE(h.origin() <= h.lastLap());
+	REQUIRE(0.0 <= h.elapsedSeconds());
+}
@@ -0,0 +1,63 @@
+// UFO
+#include <ufo/time/histogram.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+TEST_CASE("Histogram")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Histogram h;
+	REQUIRE(h.empty());
+	REQUIRE(std::isnan(h.percentileSeconds(50)));
+
+	for (int i{1}; 100 >= i; ++i) {
+		h.add(std::chrono::microseconds(i));
+	}
+
+	REQUIRE(100 == h.count());
+	REQUIRE(50.0 == Catch::Approx(h.percentileMicroseconds(50)).epsilon(1.0 / 32));
+	REQUIRE(99.0 == Catch::Approx(h.percentileMicroseconds(99)).epsilon(1.0 / 32));
+	REQUIRE(1.0 == Catch::Approx(h.percentileMicroseconds(0)).epsilon(1.0 / 32));
+
+	SECTION("Small values are exact")
+	{
+		ufo::Histogram s;
+		s.add(3ns, 10);
+		REQUIRE(3.0 == s.percentileNanoseconds(100));
+	}
+
+	SECTION("Memory usage")
+	{
+		ufo::Histogram m;
+		REQUIRE(0 == m.memoryUsage());
+
+		// The counters are dense up to the largest bucket, not only the non-empty ones
+		m.add(200ms);
+		REQUIRE(1 == m.buckets().size());
+		REQUIRE(100 * sizeof(std::uint64_t) < m.memoryUsage());
+	}
+
+	SECTION("Merge")
+	{
+		ufo::Histogram other;
+		other.add(1s, 100);
+		auto merged = h + other;
+		REQUIRE(200 == merged.count());
+		REQUIRE(1.0 == Catch::Approx(merged.percentileSeconds(75)).epsilon(1.0 / 32));
+
+		std::uint64_t count{};
+		for (auto const& [lower, upper, c] : merged.buckets()) {
+			REQUIRE(lower < upper);
+			count += c;
+		}
+		REQUIRE(200 == count);
+	}
+}
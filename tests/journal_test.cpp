@@ -0,0 +1,134 @@
+// UFO
+#include <ufo/time/journal.hpp>
+#include <ufo/time/timing.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Journal")
+{
+	auto path =
+	    (std::filesystem::temp_directory_path() / "ufotime_journal_test.bin").string();
+
+	// Small chunks so each thread fills several
+	auto journal = std::make_shared<ufo::Journal>(path, 4096);
+	REQUIRE(journal->isOpen());
+
+	ufo::Timing timing("Root");
+	timing.setJournal(journal);
+
+	auto before = std::chrono::high_resolution_clock::now();
+
+	std::vector<std::thread> threads;
+	for (int t{}; 2 > t; ++t) {
+		threads.emplace_back([&timing] {
+			for (int i{}; 1000 > i; ++i) {
+				timing.start("Outer");
+				timing.start("Inner");
+				timing.stop();
+				timing.stop();
+			}
+		});
+	}
+	for (auto& t : threads) {
+		t.join();
+	}
+
+	auto after = std::chrono::high_resolution_clock::now();
+
+	SECTION("Read")
+	{
+		// Neither flushed nor closed, as after a crash
+		ufo::JournalReader reader(path);
+		REQUIRE(reader.isOpen());
+		REQUIRE(2 < reader.numChunks());
+
+		ufo::Timing replay("Replay");
+		REQUIRE(4000 == reader.read(replay));
+		REQUIRE(2000 == replay["Outer"].timer().numSamples());
+		REQUIRE(2000 == replay["Outer"]["Inner"].timer().numSamples());
+		REQUIRE(timing["Outer"]["Inner"].timer().numSamples() ==
+		        replay["Outer"]["Inner"].timer().numSamples());
+
+		auto system = reader.toSystemTime(before);
+		REQUIRE(std::chrono::abs(std::chrono::system_clock::now() - system) <
+		        std::chrono::minutes(1));
+	}
+
+	SECTION("Window")
+	{
+		journal->flush();
+		ufo::JournalReader reader(path);
+
+		ufo::Timing replay("Replay");
+		REQUIRE(0 == reader.read(replay, before - std::chrono::hours(1), before));
+		REQUIRE(0 == reader.read(replay, after, after + std::chrono::hours(1)));
+		REQUIRE(4000 == reader.read(replay, before, after, 1));
+	}
+
+	SECTION("Truncated")
+	{
+		journal.reset();
+		timing.setJournal(nullptr);
+
+		auto size = std::filesystem::file_size(path);
+		std::filesystem::resize_file(path, size - 4096 - 100);
+
+		ufo::JournalReader reader(path);
+		ufo::Timing        replay("Replay");
+		auto               n = reader.read(replay);
+		REQUIRE(0 < n);
+		REQUIRE(4000 > n);
+	}
+
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("Journal compact")
+{
+	auto path =
+	    (std::filesystem::temp_directory_path() / "ufotime_journal_compact_test.bin")
+	        .string();
+
+	auto        journal = std::make_shared<ufo::Journal>(path);
+	ufo::Timing timing("Root");
+	timing.setJournal(journal);
+
+	timing.start("A");
+	timing.stop();
+	REQUIRE(1 == timing.compact(1));
+
+	// Likely allocated where "A" was, it must not be replayed as "A"
+	timing.start("B");
+	timing.stop();
+	timing.start("B");
+	timing.stop();
+
+	ufo::JournalReader reader(path);
+	ufo::Timing        replay("Replay");
+	REQUIRE(3 == reader.read(replay));
+	REQUIRE(1 == replay["A"].timer().numSamples());
+	REQUIRE(2 == replay["B"].timer().numSamples());
+
+	// Reading statistics replaces the nodes, likewise they must not be replayed as "B"
+	std::stringstream metrics("ufotime_samples_total{path=\"Root/C\"} 1\n# EOF\n");
+	REQUIRE(timing.readOpenMetrics(metrics));
+	timing.start("D");
+	timing.stop();
+
+	ufo::JournalReader after_read(path);
+	ufo::Timing        replay_after_read("Replay");
+	REQUIRE(4 == after_read.read(replay_after_read));
+	REQUIRE(2 == replay_after_read["B"].timer().numSamples());
+	REQUIRE(1 == replay_after_read["D"].timer().numSamples());
+
+	std::filesystem::remove(path);
+}
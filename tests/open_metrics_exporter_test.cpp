@@ -0,0 +1,105 @@
+// UFO
+#include <ufo/time/open_metrics_exporter.hpp>
+#include <ufo/time/timing.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// POSIX
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+TEST_CASE("OpenMetrics")
+{
+	ufo::Timing t("Total");
+
+	for (int i{}; 3 > i; ++i) {
+		t.start("First");
+		t.start("A \"quoted\"");
+		t.stop();
+		t.stop();
+	}
+
+	std::string text = t.openMetrics();
+
+	REQUIRE(std::string::npos != text.find("# TYPE ufotime_samples counter\n"));
+	REQUIRE(std::string::npos != text.find("ufotime_samples_total{path=\"Total/First\"} 3\n"));
+	REQUIRE(std::string::npos !=
+	        text.find("ufotime_samples_total{path=\"Total/First/A \\\"quoted\\\"\"} 3\n"));
+	REQUIRE(std::string::npos != text.find("# UNIT ufotime_seconds seconds\n"));
+	REQUIRE(std::string::npos != text.find("ufotime_min_seconds{path=\"Total\"} NaN\n"));
+	REQUIRE(text.size() - 6 == text.rfind("# EOF\n"));
+
+	SECTION("File")
+	{
+		ufo::OpenMetricsExporter exporter(t);
+		auto path = std::filesystem::temp_directory_path() / "ufotime_open_metrics_test.prom";
+		REQUIRE(exporter.write(path.string()));
+
+		std::stringstream ss;
+		ss << std::ifstream(path).rdbuf();
+		std::filesystem::remove(path);
+		REQUIRE(text == ss.str());
+	}
+
+	SECTION("Periodic file")
+	{
+		ufo::OpenMetricsExporter exporter(t);
+		auto                     path =
+		    std::filesystem::temp_directory_path() / "ufotime_open_metrics_periodic_test.prom";
+		std::filesystem::remove(path);
+		exporter.writePeriodically(path.string(), std::chrono::milliseconds(10));
+		for (int i{}; 100 > i && !std::filesystem::exists(path); ++i) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		exporter.stop();
+
+		std::stringstream ss;
+		ss << std::ifstream(path).rdbuf();
+		std::filesystem::remove(path);
+		REQUIRE(text == ss.str());
+	}
+
+	SECTION("HTTP")
+	{
+		// A free port on the loopback address
+		int         s = ::socket(AF_INET, SOCK_STREAM, 0);
+		sockaddr_in addr{};
+		addr.sin_family      = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		socklen_t len        = sizeof(addr);
+		REQUIRE(0 == ::bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)));
+		REQUIRE(0 == ::getsockname(s, reinterpret_cast<sockaddr*>(&addr), &len));
+		::close(s);
+
+		ufo::OpenMetricsExporter exporter(t);
+		REQUIRE(exporter.serve(ntohs(addr.sin_port)));
+
+		int client = ::socket(AF_INET, SOCK_STREAM, 0);
+		REQUIRE(0 == ::connect(client, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)));
+		std::string request = "GET /metrics HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+		REQUIRE(static_cast<ssize_t>(request.size()) ==
+		        ::send(client, request.data(), request.size(), MSG_NOSIGNAL));
+
+		std::string response;
+		char        buf[1024];
+		for (ssize_t n; 0 < (n = ::recv(client, buf, sizeof(buf), 0));) {
+			response.append(buf, n);
+		}
+		::close(client);
+		exporter.stop();
+
+		REQUIRE(0 == response.rfind("HTTP/1.1 200 OK\r\n", 0));
+		REQUIRE(response.size() - 6 == response.rfind("# EOF\n"));
+	}
+}
@@ -0,0 +1,93 @@
+// UFO
+#include <ufo/time/benchmark.hpp>
+#include <ufo/time/profiler.hpp>
+#include <ufo/time/timing.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <cmath>
+#include <ctime>
+
+namespace
+{
+// Burns `ms` milliseconds of CPU time of the calling thread
+void burn(long ms)
+{
+	auto cpu = [] {
+		timespec ts;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+		return ts.tv_sec * 1'000'000'000L + ts.tv_nsec;
+	};
+
+	double x     = 1.0;
+	auto   start = cpu();
+	while (cpu() - start < ms * 1'000'000L) {
+		for (int i{}; 1000 > i; ++i) {
+			x = std::sqrt(x + i);
+		}
+		ufo::doNotOptimize(x);
+	}
+}
+}  // namespace
+
+TEST_CASE("Profiler")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Timing timing("Total");
+
+	ufo::ProfilerOptions options;
+	options.interval = 1ms;
+
+	ufo::Profiler profiler(timing, options);
+	REQUIRE(profiler.start());
+	REQUIRE(profiler.running());
+
+	ufo::Profiler other(timing);
+	REQUIRE(!other.start());
+
+	burn(20);
+	timing.start("Heavy");
+	burn(100);
+	timing.start("Light");
+	burn(20);
+	timing.stop();
+	timing.stop();
+	// The root stays running once a child has been started
+	burn(20);
+
+	profiler.stop();
+	REQUIRE(!profiler.running());
+
+	auto const n = profiler.numSamples();
+	REQUIRE(0 == profiler.numDropped());
+	// CPU time timers expire on scheduler ticks, so fewer samples than one per interval
+	REQUIRE(10 < n);
+
+	auto scopes = profiler.scopes();
+	REQUIRE(4 == scopes.size());
+	// Samples outside of any scope come first
+	REQUIRE(scopes[0].path.empty());
+	REQUIRE(std::vector<std::string>{"Total"} == scopes[1].path);
+	REQUIRE(std::vector<std::string>{"Total", "Heavy"} == scopes[2].path);
+	REQUIRE(std::vector<std::string>{"Total", "Heavy", "Light"} == scopes[3].path);
+
+	REQUIRE(scopes[2].samples > scopes[3].samples);
+	REQUIRE(scopes[2].samples + scopes[3].samples == scopes[2].total);
+	REQUIRE(scopes[1].samples + scopes[2].total == scopes[1].total);
+	REQUIRE(n == scopes[0].samples + scopes[1].total);
+	REQUIRE(!scopes[2].functions.empty());
+	REQUIRE(scopes[2].samples >= scopes[2].functions[0].self);
+
+	// No more samples are taken once stopped
+	burn(10);
+	REQUIRE(n == profiler.numSamples());
+
+	profiler.clear();
+	REQUIRE(0 == profiler.numSamples());
+	REQUIRE(other.start());
+	other.stop();
+}
@@ -0,0 +1,74 @@
+// UFO
+#include <ufo/time/real_time_timing.hpp>
+#include <ufo/time/timing.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <thread>
+
+TEST_CASE("RealTimeTiming")
+{
+	ufo::Timing t("Total");
+
+	// Warmup
+	t.start("Control");
+	t.start("Read");
+	t.stop();
+	t.stop();
+
+	ufo::RealTimeTiming rt(t, 2, 2);
+	// With an overflow node for each node
+	REQUIRE(6 == rt.numNodes());
+
+	REQUIRE(!rt.start("Control"));
+	REQUIRE(rt.attach());
+	REQUIRE(rt.attach());
+	REQUIRE(1 == rt.numThreads());
+
+	for (int i{}; 10 > i; ++i) {
+		REQUIRE(rt.start("Control"));
+		rt.start("Read");
+		// Too deep
+		rt.start("Parse");
+		rt.stop();
+		rt.stop();
+		// Not in the tree
+		rt.start("Write");
+		rt.stop();
+		REQUIRE(rt.stop());
+	}
+	REQUIRE(!rt.stop());
+	REQUIRE(20 == rt.numOverflows());
+
+	auto& control = t["Control"];
+	REQUIRE(1 == control.timer().numSamples());
+	rt.flush();
+	REQUIRE(11 == control.timer().numSamples());
+	REQUIRE(11 == control["Read"].timer().numSamples());
+	REQUIRE(10 == control[ufo::Timing::otherTag()].timer().numSamples());
+
+	// Only new samples are added
+	rt.flush();
+	REQUIRE(11 == control.timer().numSamples());
+
+	bool        attached{};
+	std::thread worker([&rt, &attached] {
+		attached = rt.attach();
+		rt.start("Control");
+		rt.stop();
+	});
+	worker.join();
+	REQUIRE(attached);
+
+	rt.flush();
+	REQUIRE(12 == control.timer().numSamples());
+
+	// No more threads than given can attach
+	ufo::RealTimeTiming full(t, 1);
+	REQUIRE(full.attach());
+	std::thread other([&full, &attached] { attached = full.attach(); });
+	other.join();
+	REQUIRE(!attached);
+}
@@ -0,0 +1,112 @@
+// UFO
+#include <ufo/time/shared_memory.hpp>
+#include <ufo/time/timing.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+// POSIX
+#include <unistd.h>
+
+TEST_CASE("Shared memory")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Timing driver("Driver");
+	ufo::Timing planner("Planner");
+
+	for (int i{}; 3 > i; ++i) {
+		driver.start("Step");
+		driver.start("Sense");
+		std::this_thread::sleep_for(1ms);
+		driver.stop();
+		driver.stop();
+	}
+	planner.start("Step");
+	planner.stop();
+
+	ufo::SharedMemoryPublisher driver_publisher(driver, "ufotime.test.driver");
+	ufo::SharedMemoryPublisher planner_publisher(planner, "ufotime.test.planner", 2);
+	REQUIRE(driver_publisher.isOpen());
+	REQUIRE(planner_publisher.isOpen());
+
+	auto names = ufo::SharedMemoryReader::publishers("ufotime.test.");
+	REQUIRE(std::find(std::begin(names), std::end(names), "ufotime.test.driver") !=
+	        std::end(names));
+
+	ufo::SharedMemoryReader reader("ufotime.test.driver");
+	REQUIRE(reader.isOpen());
+	REQUIRE(0 == reader.numPublished());
+	REQUIRE(static_cast<std::int64_t>(::getpid()) == reader.pid());
+	REQUIRE(reader.alive());
+
+	REQUIRE(driver_publisher.publish());
+	REQUIRE(1 == reader.numPublished());
+
+	SECTION("Read")
+	{
+		ufo::Timing copy("Copy");
+		REQUIRE(reader.read(copy));
+
+		auto expected = driver["Step"]["Sense"].timer();
+		auto actual   = copy["Step"]["Sense"].timer();
+		REQUIRE(3 == actual.numSamples());
+		REQUIRE(expected.totalMilliseconds() == Catch::Approx(actual.totalMilliseconds()));
+		REQUIRE(expected.meanMilliseconds() == Catch::Approx(actual.meanMilliseconds()));
+		REQUIRE(expected.stdMilliseconds() == Catch::Approx(actual.stdMilliseconds()));
+		REQUIRE(expected.minMilliseconds() == Catch::Approx(actual.minMilliseconds()));
+		REQUIRE(expected.maxMilliseconds() == Catch::Approx(actual.maxMilliseconds()));
+	}
+
+	SECTION("Aggregate")
+	{
+		REQUIRE(planner_publisher.publish());
+
+		ufo::Timing machine("Machine");
+		for (auto const& name : {"ufotime.test.driver", "ufotime.test.planner"}) {
+			REQUIRE(ufo::SharedMemoryReader(name).read(machine));
+		}
+		REQUIRE(4 == machine["Step"].timer().numSamples());
+		REQUIRE(3 == machine["Step"]["Sense"].timer().numSamples());
+	}
+
+	SECTION("Periodically")
+	{
+		driver_publisher.publishPeriodically(1ms);
+		std::this_thread::sleep_for(20ms);
+		driver_publisher.stop();
+		REQUIRE(2 < reader.numPublished());
+	}
+
+	SECTION("Taken")
+	{
+		// The segment in use is neither truncated nor taken over
+		ufo::SharedMemoryPublisher other(planner, "ufotime.test.driver");
+		REQUIRE(!other.isOpen());
+		REQUIRE(1 == reader.numPublished());
+
+		ufo::Timing copy("Copy");
+		REQUIRE(reader.read(copy));
+		REQUIRE(3 == copy["Step"]["Sense"].timer().numSamples());
+	}
+
+	SECTION("Capacity")
+	{
+		// The children are visited in order of their tags, only the root and "Plan" fit
+		planner.start("Plan");
+		planner.stop();
+		REQUIRE(planner_publisher.publish());
+
+		ufo::Timing copy("Copy");
+		REQUIRE(ufo::SharedMemoryReader("ufotime.test.planner").read(copy));
+		REQUIRE(1 == copy["Plan"].timer().numSamples());
+		REQUIRE(0 == copy["Step"].timer().numSamples());
+	}
+}
@@ -0,0 +1,92 @@
+// UFO
+#include <ufo/time/time_series.hpp>
+#include <ufo/time/timing.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+TEST_CASE("TimeSeries")
+{
+	using namespace std::chrono_literals;
+
+	using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+	ufo::TimeSeries series({{1s, 10}, {10s, 3}});
+	REQUIRE(2 == series.numResolutions());
+	REQUIRE(series.intervals().empty());
+
+	// A sample per 100 ms for 25 s, with a stall every 5 s
+	for (int i{}; 250 > i; ++i) {
+		TimePoint stop{100ms * (i + 1) - 1ns};
+		series.add(stop - (0 == (i + 1) % 50 ? 200ms : 1ms), stop);
+	}
+
+	// Only the last 10 s are kept at the finest resolution
+	auto fine = series.intervals(0);
+	REQUIRE(10 == fine.size());
+	for (auto const& interval : fine) {
+		REQUIRE(10 == interval.timer.numSamples());
+	}
+	REQUIRE(200.0 == Catch::Approx(fine[4].timer.maxMilliseconds()));
+	REQUIRE(1.0 == Catch::Approx(fine[5].timer.maxMilliseconds()));
+	REQUIRE(200.0 == Catch::Approx(fine[9].histogram.percentileMilliseconds(99))
+	                     .epsilon(1.0 / 32));
+	REQUIRE(1s == std::chrono::duration_cast<std::chrono::seconds>(fine[1].start -
+	                                                                fine[0].start));
+
+	auto coarse = series.intervals(1);
+	REQUIRE(3 == coarse.size());
+	REQUIRE(50 == coarse[2].timer.numSamples());
+	REQUIRE(100 == coarse[1].timer.numSamples());
+
+	// Intervals without samples are kept, so the series is equally spaced
+	series.add(TimePoint{27500ms}, TimePoint{27501ms});
+	fine = series.intervals(0);
+	REQUIRE(10 == fine.size());
+	REQUIRE(0 == fine[8].timer.numSamples());
+	REQUIRE(1 == fine[9].timer.numSamples());
+
+	// Older than the fine ring, it would otherwise replace the interval at 20 s
+	series.add(TimePoint{500ms}, TimePoint{501ms});
+	REQUIRE(10 == series.intervals(0)[2].timer.numSamples());
+	REQUIRE(101 == series.intervals(1)[0].timer.numSamples());
+
+	std::stringstream ss;
+	series.writeJson(ss);
+	REQUIRE(std::string::npos != ss.str().find("\"interval\": 10"));
+	REQUIRE(std::string::npos != ss.str().find("\"histogram\": [["));
+
+	// The histograms of the intervals are counted, which dominate the memory
+	std::size_t histogram_bytes{};
+	for (std::size_t r{}; series.numResolutions() > r; ++r) {
+		for (auto const& interval : series.intervals(r)) {
+			histogram_bytes += interval.histogram.memoryUsage();
+		}
+	}
+	REQUIRE(histogram_bytes < series.memoryUsage());
+
+	series.reset();
+	REQUIRE(series.intervals(1).empty());
+
+	// A timing records its samples in the series
+	ufo::Timing t("Total");
+	REQUIRE(!t.recordsSeries());
+	REQUIRE(0 == t.series().numResolutions());
+	t["Save"].recordSeries();
+	REQUIRE(t["Save"].recordsSeries());
+	t.start("Save");
+	t.stop();
+	t["Save"].addSample(TimePoint{}, TimePoint{1ms});
+	REQUIRE(2 == t["Save"].series().numResolutions());
+	REQUIRE(1 == t["Save"].series().intervals().back().timer.numSamples());
+
+	t["Save"].recordSeries({});
+	REQUIRE(!t["Save"].recordsSeries());
+}
@@ -0,0 +1,143 @@
+// UFO
+#include <ufo/time/timed_mutex.hpp>
+#include <ufo/time/timing.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+TEST_CASE("TimedMutex")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Timing     timing("Map");
+	ufo::TimedMutex m(timing, 1);
+
+	for (int i{}; 10 > i; ++i) {
+		std::lock_guard lock(m);
+	}
+
+	auto s = m.stats();
+	REQUIRE(10 == s.uncontended);
+	REQUIRE(0 == s.contended);
+	REQUIRE(10 == s.hold_uncontended.numSamples());
+	REQUIRE(0 == s.wait.numSamples());
+
+	// The holder signals once it holds the lock, so this thread has to wait for it
+	std::atomic<bool> held{false};
+
+	std::thread holder([&m, &held] {
+		std::lock_guard lock(m);
+		held = true;
+		std::this_thread::sleep_for(10ms);
+	});
+	while (!held) {
+		std::this_thread::yield();
+	}
+	{
+		std::lock_guard lock(m);
+		std::this_thread::sleep_for(5ms);
+	}
+	holder.join();
+
+	s = m.stats();
+	REQUIRE(11 == s.uncontended);
+	REQUIRE(1 == s.contended);
+	REQUIRE(1 == s.wait.numSamples());
+	REQUIRE(0.0 < s.wait.maxSeconds());
+	REQUIRE(5ms <= std::chrono::duration<double>(s.hold_contended.maxSeconds()));
+	REQUIRE(10ms <= std::chrono::duration<double>(s.hold_uncontended.maxSeconds()));
+
+	REQUIRE(1 == timing["Contended wait"].timer().numSamples());
+	REQUIRE(1 == timing["Contended hold"].timer().numSamples());
+	REQUIRE(11 == timing["Uncontended hold"].timer().numSamples());
+
+	// Sampled hold time
+	ufo::TimedMutex sampled(4);
+	for (int i{}; 8 > i; ++i) {
+		REQUIRE(sampled.try_lock());
+		sampled.unlock();
+	}
+	REQUIRE(8 == sampled.stats().uncontended);
+	REQUIRE(2 == sampled.stats().hold_uncontended.numSamples());
+
+	sampled.resetStats();
+	REQUIRE(0 == sampled.stats().uncontended);
+
+	// The hold time is not sampled by default
+	ufo::TimedMutex quiet;
+	for (int i{}; 8 > i; ++i) {
+		std::lock_guard lock(quiet);
+	}
+	REQUIRE(8 == quiet.stats().uncontended);
+	REQUIRE(0 == quiet.stats().hold_uncontended.numSamples());
+}
+
+TEST_CASE("TimedSharedMutex")
+{
+	using namespace std::chrono_literals;
+
+	ufo::TimedSharedMutex m;
+
+	std::thread       writer;
+	std::atomic<bool> started{false};
+	{
+		std::shared_lock lock(m);
+		REQUIRE(m.try_lock_shared());
+		m.unlock_shared();
+
+		// The writer has to be waiting before the shared lock is released
+		writer = std::thread([&m, &started] {
+			started = true;
+			std::lock_guard lock(m);
+		});
+		while (!started) {
+			std::this_thread::yield();
+		}
+		std::this_thread::sleep_for(20ms);
+	}
+	writer.join();
+
+	auto s = m.stats();
+	REQUIRE(2 == s.shared_uncontended);
+	REQUIRE(1 == s.contended);
+	REQUIRE(5ms <= std::chrono::duration<double>(s.wait.maxSeconds()));
+}
+
+TEST_CASE("TimedConditionVariable")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Timing                 timing("Queue");
+	ufo::TimedMutex             m;
+	ufo::TimedConditionVariable cv(timing);
+
+	bool ready = false;
+
+	std::thread producer([&] {
+		std::this_thread::sleep_for(5ms);
+		{
+			std::lock_guard lock(m);
+			ready = true;
+		}
+		cv.notify_one();
+	});
+
+	{
+		std::unique_lock lock(m);
+		cv.wait(lock, [&ready] { return ready; });
+		REQUIRE(!cv.wait_for(lock, 1ms, [] { return false; }));
+	}
+	producer.join();
+
+	REQUIRE(1 <= cv.timeouts());
+	REQUIRE(2 <= cv.waitTimer().numSamples());
+	REQUIRE(cv.waitTimer().numSamples() ==
+	        timing["Condition wait"].timer().numSamples());
+}
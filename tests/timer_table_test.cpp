@@ -0,0 +1,92 @@
+// UFO
+#include <ufo/time/timer_table.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST_CASE("TimerTable")
+{
+	using namespace std::chrono_literals;
+
+	// Key is (depth, node type)
+	ufo::TimerTable<std::uint32_t> table(4);
+
+	REQUIRE(table.empty());
+	REQUIRE(0 == table.timer(0).numSamples());
+
+	for (std::uint32_t depth{}; 16 > depth; ++depth) {
+		for (std::uint32_t type{}; 1000 > type; ++type) {
+			table.add(depth << 16 | type, std::chrono::microseconds(depth + 1));
+			table.add(depth << 16 | type, std::chrono::microseconds(3 * (depth + 1)));
+		}
+	}
+
+	REQUIRE(16000 == table.size());
+	REQUIRE(table.contains(3 << 16 | 7));
+	REQUIRE(!table.contains(16 << 16));
+
+	auto t = table.timer(3 << 16 | 7);
+	REQUIRE(2 == t.numSamples());
+	REQUIRE(Catch::Approx(16.0) == t.totalMicroseconds());
+	REQUIRE(Catch::Approx(8.0) == t.meanMicroseconds());
+	REQUIRE(Catch::Approx(4.0) == t.minMicroseconds());
+	REQUIRE(Catch::Approx(12.0) == t.maxMicroseconds());
+	REQUIRE(Catch::Approx(32.0) == t.sampleVarianceMicroseconds());
+
+	auto top = table.topK(3, decltype(table)::By::MAX);
+	REQUIRE(3 == top.size());
+	REQUIRE(15u == top[0].first >> 16);
+	REQUIRE(Catch::Approx(48.0) == top[0].second.maxMicroseconds());
+
+	auto depth_0 = table.aggregate([](std::uint32_t key) { return 0 == key >> 16; });
+	REQUIRE(2000 == depth_0.numSamples());
+	REQUIRE(Catch::Approx(2.0) == depth_0.meanMicroseconds());
+	REQUIRE(Catch::Approx(1.0) == depth_0.populationVarianceMicroseconds());
+
+	auto all = table.aggregate();
+	REQUIRE(32000 == all.numSamples());
+	REQUIRE(Catch::Approx(17.0) == all.meanMicroseconds());
+
+	std::vector<std::thread> threads;
+	for (int i{}; 4 > i; ++i) {
+		threads.emplace_back([&table] {
+			for (std::uint32_t key{}; 10000 > key; ++key) {
+				table.add(1u << 24 | key, 1us);
+			}
+		});
+	}
+	for (auto& th : threads) {
+		th.join();
+	}
+	REQUIRE(26000 == table.size());
+	REQUIRE(4 == table.timer(1u << 24 | 42).numSamples());
+
+	table.clear();
+	REQUIRE(table.empty());
+}
+
+TEST_CASE("TimerTable keys spaced by a power of two")
+{
+	using namespace std::chrono_literals;
+
+	// Keys with all low bits equal would share a slot if only the low bits were used
+	ufo::TimerTable<std::uint64_t> table(1);
+	for (std::uint64_t id{}; 1 << 15 > id; ++id) {
+		table.add(id << 32, std::chrono::microseconds(id + 1));
+	}
+
+	REQUIRE(1 << 15 == table.size());
+	for (std::uint64_t id{}; 1 << 15 > id; id += 1000) {
+		REQUIRE(1 == table.timer(id << 32).numSamples());
+		REQUIRE(Catch::Approx(id + 1.0) == table.timer(id << 32).totalMicroseconds());
+	}
+	REQUIRE(!table.contains(std::uint64_t(1) << 31));
+}
@@ -2,11 +2,16 @@
 #include <ufo/time/timer.hpp>
 
 // Catch2
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 // STL
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
 // #include <thread>
 
 TEST_CASE("Timer")
@@ -30,4 +35,73 @@ TEST_CASE("Timer")
 	// std::cout << t.stdNanoseconds() << std::endl;
 	// std::cout << t.meanNanoseconds() << std::endl;
 	// std::cout << t.totalNanoseconds() << std::endl;
-}
\ No newline at end of file
+}
+
+TEST_CASE("Timer bulk samples")
+{
+	using namespace std::chrono_literals;
+
+	using Duration  = std::chrono::high_resolution_clock::duration;
+	using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+	std::mt19937                                 gen(42);
+	std::lognormal_distribution<double>          dist(10.0, 1.0);
+	std::vector<Duration>                        samples;
+	std::vector<std::pair<TimePoint, TimePoint>> intervals;
+	TimePoint                                    now{1s};
+	for (std::size_t i{}; 5000 > i; ++i) {
+		samples.push_back(std::chrono::duration_cast<Duration>(
+		    std::chrono::duration<double, std::nano>(dist(gen))));
+		intervals.emplace_back(now, now + samples.back());
+		now += 1ms;
+	}
+
+	// Reference, two passes in long double
+	long double total{};
+	for (auto s : samples) {
+		total += std::chrono::duration<long double, std::nano>(s).count();
+	}
+	long double mean = total / samples.size();
+	long double ssd{};
+	for (auto s : samples) {
+		auto d = std::chrono::duration<long double, std::nano>(s).count() - mean;
+		ssd += d * d;
+	}
+	auto variance   = static_cast<double>(ssd / (samples.size() - 1));
+	auto [min, max] = std::minmax_element(std::begin(samples), std::end(samples));
+
+	ufo::Timer bulk;
+	bulk.addSamples(std::begin(samples), std::end(samples));
+
+	ufo::Timer pairs;
+	pairs.addSamples(intervals.data(), intervals.size());
+
+	// Merging keeps the variance of the combined samples
+	ufo::Timer merged;
+	ufo::Timer second;
+	merged.addSamples(samples.data(), 1234);
+	second.addSamples(samples.data() + 1234, samples.size() - 1234);
+	merged += second;
+
+	for (auto const& t : {bulk, pairs, merged}) {
+		REQUIRE(static_cast<int>(samples.size()) == t.numSamples());
+		REQUIRE(static_cast<double>(total) == t.totalNanoseconds());
+		REQUIRE(std::chrono::duration<double, std::nano>(*min).count() ==
+		        t.minNanoseconds());
+		REQUIRE(std::chrono::duration<double, std::nano>(*max).count() ==
+		        t.maxNanoseconds());
+		REQUIRE(static_cast<double>(mean) == Catch::Approx(t.meanNanoseconds()));
+		REQUIRE(variance == Catch::Approx(t.sampleVarianceNanoseconds()));
+	}
+
+	// Only the samples with a stop time are ordered, so only they set the last sample
+	auto last = std::chrono::duration<double, std::nano>(samples.back()).count();
+	REQUIRE(0.0 == bulk.lastNanoseconds());
+	REQUIRE(last == pairs.lastNanoseconds());
+
+	// An older sample merged later does not replace it
+	ufo::Timer older;
+	older.addSample(intervals.front().first - 1s, intervals.front().first);
+	pairs += older;
+	REQUIRE(last == pairs.lastNanoseconds());
+}
@@ -0,0 +1,104 @@
+// UFO
+#include <ufo/time/statistics.hpp>
+#include <ufo/time/timing.hpp>
+#include <ufo/time/timing_diff.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <sstream>
+#include <string>
+
+namespace
+{
+std::string report(double a_mean, double a_stddev)
+{
+	std::stringstream ss;
+	ss << "ufotime_samples_total{path=\"Total\"} 0\n"
+	   << "ufotime_samples_total{path=\"Total/A\"} 100\n"
+	   << "ufotime_samples_total{path=\"Total/B\"} 100\n"
+	   << "ufotime_mean_seconds{path=\"Total/A\"} " << a_mean << '\n'
+	   << "ufotime_stddev_seconds{path=\"Total/A\"} " << a_stddev << '\n'
+	   << "ufotime_mean_seconds{path=\"Total/B\"} 0.5\n"
+	   << "ufotime_stddev_seconds{path=\"Total/B\"} 0.1\n"
+	   << "# EOF\n";
+	return ss.str();
+}
+}  // namespace
+
+TEST_CASE("Statistics")
+{
+	REQUIRE(0.5 == Catch::Approx(ufo::studentTCdf(0.0, 5.0)));
+	REQUIRE(0.963306 == Catch::Approx(ufo::studentTCdf(2.0, 10.0)).epsilon(1e-5));
+	REQUIRE(0.036694 == Catch::Approx(ufo::studentTCdf(-2.0, 10.0)).epsilon(1e-4));
+
+	auto test = ufo::welchTTest(1.0, 1.0, 10, 2.0, 4.0, 20);
+	REQUIRE(1.8257 == Catch::Approx(test.t).epsilon(1e-4));
+	REQUIRE(27.98 == Catch::Approx(test.df).epsilon(1e-3));
+}
+
+TEST_CASE("TimingDiff")
+{
+	ufo::Timing baseline;
+	ufo::Timing candidate;
+
+	std::stringstream b(report(1.0, 0.1));
+	std::stringstream c(report(1.2, 0.1));
+	REQUIRE(baseline.readOpenMetrics(b));
+	REQUIRE(candidate.readOpenMetrics(c));
+	REQUIRE("Total" == candidate.tag());
+
+	candidate.start("C");
+	candidate.stop();
+
+	ufo::TimingDiff diff(baseline, candidate);
+
+	auto const& nodes = diff.nodes();
+	REQUIRE(4 == nodes.size());
+	REQUIRE("Total/A" == nodes[1].path);
+	REQUIRE(ufo::TimingDiff::Change::REGRESSION == nodes[1].change);
+	REQUIRE(0.2 == Catch::Approx(nodes[1].delta()));
+	REQUIRE(ufo::TimingDiff::Change::NONE == nodes[2].change);
+	REQUIRE(ufo::TimingDiff::Change::ADDED == nodes[3].change);
+	REQUIRE(1 == diff.regressions().size());
+	REQUIRE(diff.improvements().empty());
+
+	ufo::TimingDiff reverse(candidate, baseline);
+	REQUIRE(1 == reverse.improvements().size());
+	REQUIRE(ufo::TimingDiff::Change::REMOVED == reverse.nodes()[3].change);
+
+	// Unchanged nodes are kept only as the parents of changed nodes
+	auto nested = [](double a_mean) {
+		std::stringstream ss;
+		ss << "ufotime_samples_total{path=\"Total\"} 0\n"
+		   << "ufotime_samples_total{path=\"Total/A\"} 100\n"
+		   << "ufotime_samples_total{path=\"Total/A/X\"} 100\n"
+		   << "ufotime_samples_total{path=\"Total/B\"} 100\n"
+		   << "ufotime_mean_seconds{path=\"Total/A\"} 2.0\n"
+		   << "ufotime_stddev_seconds{path=\"Total/A\"} 0.1\n"
+		   << "ufotime_mean_seconds{path=\"Total/A/X\"} " << a_mean << '\n'
+		   << "ufotime_stddev_seconds{path=\"Total/A/X\"} 0.1\n"
+		   << "ufotime_mean_seconds{path=\"Total/B\"} 0.5\n"
+		   << "ufotime_stddev_seconds{path=\"Total/B\"} 0.1\n"
+		   << "# EOF\n";
+		return ss.str();
+	};
+	ufo::Timing       nested_baseline;
+	ufo::Timing       nested_candidate;
+	std::stringstream nb(nested(1.0));
+	std::stringstream nc(nested(1.2));
+	REQUIRE(nested_baseline.readOpenMetrics(nb));
+	REQUIRE(nested_candidate.readOpenMetrics(nc));
+
+	ufo::TimingDiff nested_diff(nested_baseline, nested_candidate);
+	REQUIRE(4 == nested_diff.nodes().size());
+	auto tree = nested_diff.changedTree();
+	REQUIRE(3 == tree.size());
+	REQUIRE("Total" == tree[0].path);
+	REQUIRE("Total/A" == tree[1].path);
+	REQUIRE(ufo::TimingDiff::Change::NONE == tree[1].change);
+	REQUIRE("Total/A/X" == tree[2].path);
+	REQUIRE(ufo::TimingDiff::Change::REGRESSION == tree[2].change);
+}
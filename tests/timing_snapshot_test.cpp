@@ -0,0 +1,58 @@
+// UFO
+#include <ufo/time/timer.hpp>
+#include <ufo/time/timing.hpp>
+#include <ufo/time/timing_snapshot.hpp>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// STL
+#include <chrono>
+#include <cmath>
+
+TEST_CASE("TimingSnapshot")
+{
+	using namespace std::chrono_literals;
+
+	using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+	ufo::Timing timing;
+	auto&       a = timing["A"];
+	for (auto d : {1ms, 2ms, 3ms, 4ms, 5ms}) {
+		a.addSample(TimePoint{}, TimePoint{d});
+	}
+
+	ufo::TimingSnapshot previous(timing);
+
+	ufo::Timer expected;
+	for (auto d : {10ms, 20ms, 30ms}) {
+		a.addSample(TimePoint{}, TimePoint{d});
+		expected.addSample(TimePoint{}, TimePoint{d});
+	}
+	timing["B"].addSample(TimePoint{}, TimePoint{7ms});
+
+	ufo::TimingSnapshot current(timing);
+	auto                delta = current - previous;
+	REQUIRE(previous.time() == delta.start());
+	REQUIRE(current.time() == delta.time());
+
+	auto const& t = delta["A"].timer();
+	REQUIRE(3 == t.numSamples());
+	REQUIRE(60.0 == Catch::Approx(t.totalMilliseconds()));
+	REQUIRE(expected.meanMilliseconds() == Catch::Approx(t.meanMilliseconds()));
+	REQUIRE(expected.sampleVarianceMilliseconds() ==
+	        Catch::Approx(t.sampleVarianceMilliseconds()));
+	// The smallest new sample is hidden by the older minimum
+	REQUIRE(std::isnan(t.minMilliseconds()));
+	REQUIRE(30.0 == t.maxMilliseconds());
+
+	// New nodes keep all their samples
+	REQUIRE(1 == delta["B"].timer().numSamples());
+	REQUIRE(0 == delta["C"].timer().numSamples());
+
+	// Nothing happened since the last snapshot
+	auto empty = current - current;
+	REQUIRE(0 == empty["A"].timer().numSamples());
+	REQUIRE(0.0 == empty["A"].timer().totalMilliseconds());
+}
@@ -2,10 +2,18 @@
 #include <ufo/time/timing.hpp>
 
 // Catch2
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 // STL
+#include <cmath>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 
 TEST_CASE("Timing")
 {
@@ -235,4 +243,422 @@ TEST_CASE("Timing")
 	// // t1.join();
 
 	// t.printMilliseconds(true, true, true, 2, 10, 2);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Timing work")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Timing t("Total");
+
+	for (int i{}; 4 > i; ++i) {
+		t.start("Integrate");
+		t.stop({{"points", 1000}, {"bytes", 12000}});
+	}
+	t.start("Integrate");
+	std::this_thread::sleep_for(5ms);
+	t.stop();
+
+	auto work = t["Integrate"].work();
+	REQUIRE(2 == work.size());
+	REQUIRE(4000 == work["points"]);
+	REQUIRE(48000 == work["bytes"]);
+	REQUIRE(t.work().empty());
+
+	// The sample without work is not part of the throughput
+	auto seconds = t["Integrate"].workSeconds();
+	REQUIRE(2 == seconds.size());
+	REQUIRE(seconds["points"] == seconds["bytes"]);
+	REQUIRE(seconds["points"] + 0.005 <= t["Integrate"].timer().totalSeconds());
+}
+
+TEST_CASE("Timing budget")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Timing t("Total");
+
+	std::vector<std::string>                     scope;
+	std::chrono::high_resolution_clock::duration missed{};
+
+	t.start("Frame");
+	t.start("Integrate").setBudget(1ms, [&](auto elapsed, auto const& path) {
+		missed = elapsed;
+		scope  = path;
+	});
+	t.stop();
+	t.stop();
+
+	REQUIRE(t["Frame"]["Integrate"].hasBudget());
+	REQUIRE(!t["Frame"].hasBudget());
+
+	t.start("Frame");
+	t.start("Integrate");
+	std::this_thread::sleep_for(2ms);
+	t.stop();
+	t.start("Integrate");
+	t.stop();
+	t.stop();
+
+	REQUIRE(1 == t["Frame"]["Integrate"].deadlineMisses());
+	REQUIRE(2ms <= missed);
+	REQUIRE(std::vector<std::string>{"Total", "Frame", "Integrate"} == scope);
+
+	std::promise<std::thread::id> deferred;
+	t["Frame"].setBudget(
+	    0ns, [&](auto, auto const&) { deferred.set_value(std::this_thread::get_id()); },
+	    true);
+	t.start("Frame");
+	t.stop();
+	REQUIRE(std::this_thread::get_id() != deferred.get_future().get());
+	REQUIRE(1 == t["Frame"].deadlineMisses());
+
+	// Deferred callbacks of a timing destroyed before they run are dropped
+	std::promise<void> release;
+	std::promise<void> done;
+	bool               ran = false;
+	t["Blocker"].setBudget(
+	    0ns, [r = release.get_future().share()](auto, auto const&) { r.wait(); }, true);
+	t["Last"].setBudget(0ns, [&](auto, auto const&) { done.set_value(); }, true);
+	t.start("Blocker");
+	t.stop();
+	{
+		ufo::Timing destroyed("Destroyed");
+		destroyed["Frame"].setBudget(0ns, [&](auto, auto const&) { ran = true; }, true);
+		destroyed.start("Frame");
+		destroyed.stop();
+	}
+	t.start("Last");
+	t.stop();
+	release.set_value();
+	done.get_future().get();
+	REQUIRE(!ran);
+}
+
+TEST_CASE("Timing frames")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Timing t("Total");
+
+	auto& loop = t.start("Loop");
+	loop.frame(2);
+	for (int i{}; 5 > i; ++i) {
+		loop.start("Integrate");
+		std::this_thread::sleep_for(3 == i ? 50ms : 1ms);
+		loop.stop();
+		loop.start("Publish");
+		loop.stop();
+		loop.frame(2);
+	}
+	t.stop();
+
+	REQUIRE(5 == loop.numFrames());
+	REQUIRE(5 == loop.framePeriod().numSamples());
+	REQUIRE(5 == loop.framePeriodHistogram().count());
+
+	auto slowest = loop.slowestFrames();
+	REQUIRE(2 == slowest.size());
+	REQUIRE(3 == slowest[0].index);
+	REQUIRE(slowest[0].period >= slowest[1].period);
+	REQUIRE("Integrate" == slowest[0].dominant());
+	REQUIRE(2 == slowest[0].children.size());
+
+	// Fewer slowest frames drops the fastest of those kept
+	loop.frame(1);
+	slowest = loop.slowestFrames();
+	REQUIRE(1 == slowest.size());
+	REQUIRE(3 == slowest[0].index);
+}
+
+TEST_CASE("Timing slowest samples")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Timing t("Total");
+
+	t.start("Frame");
+	t.start("Integrate").captureSlowest(2);
+	t.stop();
+	t.stop();
+
+	auto before = std::chrono::system_clock::now();
+	// The two slowest come last, so scheduling delays of the others do not reorder them
+	for (auto d : {1ms, 0ms, 20ms, 10ms}) {
+		t.start("Frame");
+		t.start("Integrate");
+		std::this_thread::sleep_for(d);
+		t.stop();
+		t.stop();
+	}
+	auto after = std::chrono::system_clock::now();
+
+	auto samples = t["Frame"]["Integrate"].slowestSamples();
+	REQUIRE(2 == samples.size());
+	REQUIRE(20ms <= samples[0].duration);
+	REQUIRE(10ms <= samples[1].duration);
+	REQUIRE(samples[1].duration < samples[0].duration);
+	REQUIRE(samples[1].start > samples[0].start);
+	REQUIRE(before <= samples[0].start);
+	REQUIRE(after >= samples[1].start);
+	REQUIRE(std::this_thread::get_id() == samples[0].thread);
+	REQUIRE(std::vector<std::string>{"Total", "Frame", "Integrate"} == samples[0].path);
+	REQUIRE(t["Frame"].slowestSamples().empty());
+
+	t["Frame"]["Integrate"].captureSlowest(1);
+	REQUIRE(1 == t["Frame"]["Integrate"].slowestSamples().size());
+	REQUIRE(5ms <= t["Frame"]["Integrate"].slowestSamples()[0].duration);
+}
+
+TEST_CASE("Timing threads")
+{
+	using namespace std::chrono_literals;
+
+	ufo::Timing t("Total");
+
+	t.start("Integrate").trackThreads();
+	t.stop();
+
+	auto& integrate = t["Integrate"];
+	REQUIRE(integrate.tracksThreads());
+	REQUIRE(1 == integrate.threadTimers().size());
+
+	// One straggler, the other threads wait for it
+	std::vector<std::thread> threads;
+	std::promise<void>       go;
+	auto                     ready = go.get_future().share();
+	std::mutex               mutex;
+	std::condition_variable  cv;
+	int                      started{};
+	for (int i{}; 4 > i; ++i) {
+		threads.emplace_back([&, ready, i] {
+			ready.wait();
+			t.start("Integrate");
+			{
+				std::lock_guard lock(mutex);
+				++started;
+			}
+			cv.notify_one();
+			std::this_thread::sleep_for(0 == i ? 100ms : 10ms);
+			t.stop();
+		});
+	}
+	// All threads start before the main thread stops, so the wall time is one sample
+	t.start("Integrate");
+	go.set_value();
+	{
+		std::unique_lock lock(mutex);
+		cv.wait(lock, [&started] { return 4 == started; });
+	}
+	std::this_thread::sleep_for(5ms);
+	t.stop();
+	for (auto& th : threads) {
+		th.join();
+	}
+
+	auto timers = integrate.threadTimers();
+	REQUIRE(5 == timers.size());
+	REQUIRE(2 == integrate.wallTimer().numSamples());
+	REQUIRE(100ms <= std::chrono::duration<double>(integrate.wallTimer().lastSeconds()));
+	REQUIRE(100ms <= std::chrono::duration<double>(
+	                    timers.at(integrate.slowestThread()).totalSeconds()));
+
+	// Slowest 100 ms against a mean of (100 + 3 * 10 + 5) / 5 = 27 ms
+	REQUIRE(2.0 < integrate.imbalance());
+	// About (100 + 3 * 10 + 5) / (5 * 100)
+	REQUIRE(0.6 > integrate.parallelEfficiency());
+	REQUIRE(0.0 < integrate.parallelEfficiency());
+
+	REQUIRE(!t.tracksThreads());
+	REQUIRE(std::isnan(t.imbalance()));
+
+	// A thread already running the node when tracking starts is part of the section
+	ufo::Timing late("Total");
+	late.start("Work");
+	late["Work"].trackThreads();
+	late.stop();
+	REQUIRE(1 == late["Work"].threadTimers().size());
+	REQUIRE(1 == late["Work"].wallTimer().numSamples());
+}
+
+TEST_CASE("Timing limits")
+{
+	using namespace std::chrono_literals;
+
+	using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+	ufo::Timing t("Total");
+	t.setLimits(3, 6);
+	REQUIRE(1 == t.numNodes());
+
+	// One tag per file, past the limit they are timed together
+	for (int i{}; 5 > i; ++i) {
+		t.start("File " + std::to_string(i));
+		t.stop();
+	}
+	REQUIRE(5 == t.numNodes());
+	REQUIRE(2 == t[ufo::Timing::otherTag()].timer().numSamples());
+	REQUIRE(2 == t.numOverflows());
+
+	// The node limit applies to the whole tree, the overflow bucket is always added
+	auto& file = t["File 0"];
+	file.start("A");
+	file.stop();
+	file.start("B");
+	file.stop();
+	REQUIRE(7 == t.numNodes());
+	REQUIRE(1 == file[ufo::Timing::otherTag()].timer().numSamples());
+	REQUIRE(3 == t.numOverflows());
+
+	ufo::Timing chunks("Total");
+	for (int i{}; 5 > i; ++i) {
+		chunks["Chunk " + std::to_string(i)].addSample(TimePoint{}, TimePoint{(i + 1) * 1ms});
+	}
+	REQUIRE(6 == chunks.numNodes());
+	auto const bytes = chunks.memoryUsage();
+	REQUIRE(6 * sizeof(ufo::Timing) < bytes);
+
+	// The least significant nodes are folded first, keeping their statistics
+	REQUIRE(3 == chunks.compact(4));
+	REQUIRE(4 == chunks.numNodes());
+	REQUIRE(bytes > chunks.memoryUsage());
+	auto other = chunks[ufo::Timing::otherTag()].timer();
+	REQUIRE(3 == other.numSamples());
+	REQUIRE(6.0 == Catch::Approx(other.totalMilliseconds()));
+
+	// The overflow bucket itself is never folded
+	REQUIRE(2 == chunks.compact(1));
+	REQUIRE(2 == chunks.numNodes());
+	other = chunks[ufo::Timing::otherTag()].timer();
+	REQUIRE(5 == other.numSamples());
+	REQUIRE(15.0 == Catch::Approx(other.totalMilliseconds()));
+
+	// No room for the bytes of any new node
+	ufo::Timing small("Total");
+	small.setLimits(100, 100, 0);
+	small.start("A");
+	small.stop();
+	REQUIRE(2 == small.numNodes());
+	REQUIRE(1 == small[ufo::Timing::otherTag()].timer().numSamples());
+
+	// A tag too long for the small-string buffer is charged for its heap memory, in both
+	// the key and the node
+	std::string const long_tag(20, 'L');
+	auto const        node_bytes =
+	    4 * sizeof(void*) + sizeof(std::string) + sizeof(ufo::Timing);
+	ufo::Timing       tight("Total");
+	tight.setLimits(100, 100, node_bytes + 2 * long_tag.size());
+	tight.start(long_tag);
+	tight.stop();
+	REQUIRE(1 == tight[ufo::Timing::otherTag()].timer().numSamples());
+	tight.clearLimits();
+	tight.setLimits(100, 100, 2 * node_bytes + 2 * (long_tag.size() + 1));
+	tight.start(long_tag);
+	tight.stop();
+	REQUIRE(1 == tight[long_tag].timer().numSamples());
+
+	ufo::Timing short_tags("Total");
+	short_tags["S"];
+	ufo::Timing long_tags("Total");
+	long_tags[long_tag];
+	REQUIRE(short_tags.memoryUsage() + 2 * (long_tag.size() + 1) <= long_tags.memoryUsage());
+
+	// Reading statistics gives back what the replaced nodes used
+	ufo::Timing read("Total");
+	read.setLimits(100, 3);
+	read["A"];
+	read["B"];
+	std::stringstream metrics("ufotime_samples_total{path=\"Total/C\"} 1\n"
+	                          "ufotime_samples_total{path=\"Total/D\"} 1\n# EOF\n");
+	REQUIRE(read.readOpenMetrics(metrics));
+	REQUIRE(3 == read.numNodes());
+	REQUIRE(0 == read.numOverflows());
+
+	// Nodes added concurrently under different parents do not exceed the node limit
+	ufo::Timing              shared("Total");
+	std::vector<std::string> parents;
+	for (int i{}; 8 > i; ++i) {
+		parents.push_back("Parent " + std::to_string(i));
+		shared[parents.back()];
+	}
+	shared.setLimits(1000, 40);
+
+	std::vector<std::thread> threads;
+	for (auto const& p : parents) {
+		threads.emplace_back([&parent = shared[p]] {
+			for (int i{}; 100 > i; ++i) {
+				parent.start("Tag " + std::to_string(i));
+				parent.stop();
+			}
+		});
+	}
+	for (auto& th : threads) {
+		th.join();
+	}
+
+	// Each parent overflows, its overflow bucket is always added
+	REQUIRE(40 + 8 >= shared.numNodes());
+	REQUIRE(800 - 31 <= shared.numOverflows());
+}
+
+TEST_CASE("Timing sizes")
+{
+	using namespace std::chrono_literals;
+
+	using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+	ufo::Timing t("Total");
+	auto&       linear    = t["Linear"];
+	auto&       quadratic = t["Quadratic"];
+	auto&       nlogn     = t["N log n"];
+	for (std::size_t n = 10; 100000 >= n; n *= 10) {
+		for (int i{}; 3 > i; ++i) {
+			linear.addSample(TimePoint{}, TimePoint{n * 1us}, n);
+			quadratic.addSample(TimePoint{}, TimePoint{n * n * 1ns}, n);
+			auto ns = static_cast<long>(n * std::log2(static_cast<double>(n)));
+			nlogn.addSample(TimePoint{}, TimePoint{std::chrono::nanoseconds(ns)}, n);
+		}
+	}
+
+	auto buckets = linear.sizeBuckets();
+	REQUIRE(5 == buckets.size());
+	REQUIRE(8 == buckets[0].min_size);
+	REQUIRE(15 == buckets[0].max_size);
+	REQUIRE(10.0 == Catch::Approx(buckets[0].mean_size));
+	REQUIRE(3 == buckets[0].timer.numSamples());
+	REQUIRE(65536 == buckets[4].min_size);
+
+	auto fit = linear.complexity();
+	REQUIRE(1.0 == Catch::Approx(fit.exponent));
+	REQUIRE(ufo::Complexity::LINEAR == fit.complexity);
+	REQUIRE(1e-6 == Catch::Approx(fit.coefficient));
+
+	fit = quadratic.complexity();
+	REQUIRE(2.0 == Catch::Approx(fit.exponent));
+	REQUIRE(ufo::Complexity::QUADRATIC == fit.complexity);
+
+	REQUIRE(ufo::Complexity::LINEARITHMIC == nlogn.complexity().complexity);
+	REQUIRE(std::string("O(n^2)") == ufo::complexityName(ufo::Complexity::QUADRATIC));
+
+	// A single size says nothing about the scaling
+	ufo::Timing single("Single");
+	single.addSample(TimePoint{}, TimePoint{1ms}, 100);
+	REQUIRE(std::isnan(single.complexity().exponent));
+	REQUIRE(t.sizeBuckets().empty());
+
+	// The sample is recorded with its size
+	t.start("Scan");
+	t.stopWithSize(1000, {{"points", 1000}});
+	REQUIRE(1 == t["Scan"].timer().numSamples());
+	REQUIRE(1 == t["Scan"].sizeBuckets().size());
+	REQUIRE(1000 == Catch::Approx(t["Scan"].work().at("points")));
+	REQUIRE(512 == t["Scan"].sizeBuckets()[0].min_size);
+
+	// With the same duration as the node's own sample
+	t.start("Sort");
+	std::this_thread::sleep_for(5ms);
+	t.stopWithSize(1000);
+	auto const& sort = t["Sort"];
+	REQUIRE(0.005 <= sort.sizeBuckets()[0].timer.totalSeconds());
+	REQUIRE(sort.timer().totalSeconds() == sort.sizeBuckets()[0].timer.totalSeconds());
+}
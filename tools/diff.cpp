@@ -0,0 +1,112 @@
+// UFO
+#include <ufo/time/timing.hpp>
+#include <ufo/time/timing_diff.hpp>
+
+// STL
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+void usage(char const* program)
+{
+	std::fprintf(stderr,
+	             "Usage: %s [options] <baseline> <candidate>\n"
+	             "\n"
+	             "Compares two timing reports written by ufo::Timing::writeOpenMetrics.\n"
+	             "\n"
+	             "Options:\n"
+	             "  --alpha <value>       Significance level (default: 0.05)\n"
+	             "  --min-effect <value>  Minimum relative change of the mean (default: "
+	             "0.05)\n"
+	             "  --unit <s|ms|us|ns>   Unit of the table (default: ms)\n"
+	             "  --changed             Only show nodes that changed\n"
+	             "  --json                Write JSON instead of a table\n"
+	             "  --prefix <prefix>     Prefix of the metric names (default: ufotime)\n"
+	             "\n"
+	             "Exits with 1 if there is a significant regression.\n",
+	             program);
+}
+
+bool read(std::string const& path, std::string const& prefix, ufo::Timing& timing)
+{
+	std::ifstream file(path);
+	if (!file) {
+		std::fprintf(stderr, "Cannot open '%s'\n", path.c_str());
+		return false;
+	}
+	if (!timing.readOpenMetrics(file, prefix)) {
+		std::fprintf(stderr, "No timings in '%s'\n", path.c_str());
+		return false;
+	}
+	return true;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+	double      alpha      = 0.05;
+	double      min_effect = 0.05;
+	std::string unit       = "ms";
+	std::string prefix     = "ufotime";
+	bool        changed    = false;
+	bool        json       = false;
+	std::string files[2];
+	int         num_files = 0;
+
+	for (int i{1}; argc > i; ++i) {
+		std::string arg  = argv[i];
+		bool        more = argc > i + 1;
+		if ("--alpha" == arg && more) {
+			alpha = std::atof(argv[++i]);
+		} else if ("--min-effect" == arg && more) {
+			min_effect = std::atof(argv[++i]);
+		} else if ("--unit" == arg && more) {
+			unit = argv[++i];
+		} else if ("--prefix" == arg && more) {
+			prefix = argv[++i];
+		} else if ("--changed" == arg) {
+			changed = true;
+		} else if ("--json" == arg) {
+			json = true;
+		} else if ("-h" == arg || "--help" == arg) {
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		} else if (2 > num_files && '-' != arg[0]) {
+			files[num_files++] = arg;
+		} else {
+			usage(argv[0]);
+			return 2;
+		}
+	}
+
+	if (2 != num_files) {
+		usage(argv[0]);
+		return 2;
+	}
+
+	ufo::Timing baseline;
+	ufo::Timing candidate;
+	if (!read(files[0], prefix, baseline) || !read(files[1], prefix, candidate)) {
+		return 2;
+	}
+
+	ufo::TimingDiff diff(baseline, candidate, alpha, min_effect);
+
+	if (json) {
+		diff.writeJson(std::cout, changed);
+	} else if ("s" == unit) {
+		diff.printSeconds(changed);
+	} else if ("us" == unit) {
+		diff.printMicroseconds(changed);
+	} else if ("ns" == unit) {
+		diff.printNanoseconds(changed);
+	} else {
+		diff.printMilliseconds(changed);
+	}
+
+	return diff.regressions().empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,94 @@
+// UFO
+#include <ufo/time/shared_memory.hpp>
+#include <ufo/time/timing.hpp>
+
+// STL
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace
+{
+void usage(char const* program)
+{
+	std::fprintf(stderr,
+	             "Usage: %s [options]\n"
+	             "\n"
+	             "Shows the timings published by ufo::SharedMemoryPublisher in all "
+	             "processes.\n"
+	             "\n"
+	             "Options:\n"
+	             "  --prefix <prefix>     Prefix of the segment names (default: ufotime.)\n"
+	             "  --interval <ms>       Time between updates (default: 1000)\n"
+	             "  --unit <s|ms|us|ns>   Unit of the table (default: ms)\n"
+	             "  --merge               Merge the processes instead of one subtree each\n"
+	             "  --once                Print once and exit\n",
+	             program);
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+	std::string prefix   = "ufotime.";
+	int         interval = 1000;
+	std::string unit     = "ms";
+	bool        merge    = false;
+	bool        once     = false;
+
+	for (int i{1}; argc > i; ++i) {
+		std::string arg  = argv[i];
+		bool        more = argc > i + 1;
+		if ("--prefix" == arg && more) {
+			prefix = argv[++i];
+		} else if ("--interval" == arg && more) {
+			interval = std::atoi(argv[++i]);
+		} else if ("--unit" == arg && more) {
+			unit = argv[++i];
+		} else if ("--merge" == arg) {
+			merge = true;
+		} else if ("--once" == arg) {
+			once = true;
+		} else if ("-h" == arg || "--help" == arg) {
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		} else {
+			usage(argv[0]);
+			return 2;
+		}
+	}
+
+	while (true) {
+		ufo::Timing machine("Machine");
+		for (auto const& name : ufo::SharedMemoryReader::publishers(prefix)) {
+			ufo::SharedMemoryReader reader(name);
+			// Left behind by a process that did not exit cleanly
+			if (!reader.alive()) {
+				continue;
+			}
+			reader.read(merge ? machine : machine[name.substr(prefix.size())]);
+		}
+
+		if (!once) {
+			// Clear the screen
+			std::printf("\033[2J\033[H");
+		}
+
+		if ("s" == unit) {
+			machine.printSeconds();
+		} else if ("us" == unit) {
+			machine.printMicroseconds();
+		} else if ("ns" == unit) {
+			machine.printNanoseconds();
+		} else {
+			machine.printMilliseconds();
+		}
+		std::fflush(stdout);
+
+		if (once) {
+			return EXIT_SUCCESS;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+	}
+}